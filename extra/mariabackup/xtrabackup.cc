@@ -1397,6 +1397,7 @@ enum options_xtrabackup
   OPT_INNODB_IO_CAPACITY,
   OPT_INNODB_READ_IO_THREADS,
   OPT_INNODB_WRITE_IO_THREADS,
+  OPT_INNODB_LOG_RECOVERY_THREADS,
   OPT_INNODB_USE_NATIVE_AIO,
 #ifdef __linux__
   OPT_INNODB_LINUX_AIO,
@@ -1950,6 +1951,11 @@ struct my_option xb_server_options[] =
    "Number of background write I/O threads in InnoDB.", (G_PTR*) &innobase_write_io_threads,
    (G_PTR*) &innobase_write_io_threads, 0, GET_LONG, REQUIRED_ARG, 4, 1, 64, 0,
    1, 0},
+  {"innodb_log_recovery_threads", OPT_INNODB_LOG_RECOVERY_THREADS,
+   "Maximum number of threads that apply the redo log to pages during"
+   " --prepare; 0 (the default) uses the number of CPUs.",
+   (G_PTR*) &srv_log_recovery_threads, (G_PTR*) &srv_log_recovery_threads,
+   0, GET_UINT, REQUIRED_ARG, 0, 0, 256, 0, 1, 0},
   {"innodb_file_per_table", OPT_INNODB_FILE_PER_TABLE,
    "Stores each InnoDB table to an .ibd file in the database dir.",
    (G_PTR*) &srv_file_per_table,
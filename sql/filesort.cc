@@ -313,6 +313,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   param.set_all_read_bits= filesort->set_all_read_bits;
   param.unpack= filesort->unpack;
+  param.sort_threads= (uint) thd->variables.max_sort_threads;
 
   sort->addon_fields=  param.addon_fields;
   sort->sort_keys= param.sort_keys;
@@ -459,6 +460,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   {
     if (save_index(&param, (uint) num_rows, sort))
       goto err;
+    tracker->report_sort_threads(param.used_sort_threads);
   }
   else
   {
@@ -479,6 +481,8 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
         goto err;
     }
 
+    tracker->report_sort_threads(param.used_sort_threads);
+
     if (!(sort->buffpek.str=
           (char *) read_buffpek_from_file(&buffpek_pointers, maxbuffer,
                                           (uchar*) sort->buffpek.str)))
@@ -1173,7 +1177,7 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
   Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  set_if_bigger(param->used_sort_threads, fs_info->sort_buffer(param, count));
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
@@ -1579,7 +1583,8 @@ static bool save_index(Sort_param *param, uint count, SORT_INFO *table_sort)
   DBUG_ENTER("save_index");
   DBUG_ASSERT(table_sort->record_pointers == 0);
 
-  table_sort->sort_buffer(param, count);
+  set_if_bigger(param->used_sort_threads,
+                table_sort->sort_buffer(param, count));
 
   if (param->using_addon_fields())
   {
@@ -20,6 +20,8 @@
 #include "sql_sort.h"
 #include "table.h"
 #include "optimizer_defaults.h"
+#include "sql_parallel.h"
+#include <queues.h>
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
 
@@ -383,32 +385,186 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/*
+  Minimum number of keys that each thread gets when a buffer is sorted in
+  parallel. Below this, the cost of merging the slices and of waking up
+  the workers is higher than what is saved.
+*/
+#define MIN_KEYS_PER_SORT_THREAD 16384
+
+/**
+  Sort an array of key pointers with radix sort if a scratch buffer is
+  given, and with qsort otherwise.
+*/
+
+static void sort_key_pointers(const Sort_param *param, uchar **keys,
+                              uint count, uchar **buffer)
+{
+  size_t size= param->sort_length;
+  if (buffer)
+    radixsort_for_str_ptr(keys, count, size, buffer);
+  else
+    my_qsort2(keys, count, sizeof(uchar*), param->get_compare_function(),
+              param->get_compare_argument(&size));
+}
+
+
+namespace
+{
+/** A buffer of keys that is split into slices sorted by different threads */
+struct Parallel_sort
+{
+  const Sort_param *param;
+  uchar **keys;
+  uchar **buffer;           /* Radix sort scratch area, or NULL */
+  uint count;
+  uint n_slices;
+
+  uint slice_start(uint slice) const
+  {
+    return static_cast<uint>(static_cast<ulonglong>(count) * slice /
+                             n_slices);
+  }
+};
+
+/** Read position of one sorted slice during the final merge */
+struct Sort_slice
+{
+  uchar **pos;
+  uchar **end;
+};
+
+struct Sort_slice_compare
+{
+  qsort_cmp2 cmp;
+  void *arg;
+};
+}
+
+
+static void sort_slice(void *arg, uint slice)
+{
+  Parallel_sort *ps= static_cast<Parallel_sort*>(arg);
+  uint start= ps->slice_start(slice);
+  uint end= ps->slice_start(slice + 1);
+  sort_key_pointers(ps->param, ps->keys + start, end - start,
+                    ps->buffer ? ps->buffer + start : NULL);
+}
+
+
+static int cmp_sort_slices(void *arg, const void *a, const void *b)
+{
+  Sort_slice_compare *c= static_cast<Sort_slice_compare*>(arg);
+  return c->cmp(c->arg, static_cast<const Sort_slice*>(a)->pos,
+                static_cast<const Sort_slice*>(b)->pos);
+}
+
+
+/**
+  Sort the key pointers on several threads.
+
+  The array is split into slices that are sorted concurrently, after which
+  the slices are merged with a multi-way merge into a scratch array that
+  is finally copied back over the original one.
+
+  @return number of threads used, or 0 if the caller should sort the
+          buffer itself (not enough memory)
+*/
+
+static uint parallel_sort_key_pointers(const Sort_param *param, uchar **keys,
+                                       uint count, uint n_threads)
+{
+  Parallel_sort ps;
+  Sort_slice slices[SQL_PARALLEL_MAX_TASKS];
+  Sort_slice_compare slice_cmp;
+  size_t size= param->sort_length;
+  QUEUE queue;
+  uchar **merged;
+  DBUG_ENTER("parallel_sort_key_pointers");
+
+  if (!(merged= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
+                                     MYF(MY_THREAD_SPECIFIC))))
+    DBUG_RETURN(0);
+
+  slice_cmp.cmp= param->get_compare_function();
+  slice_cmp.arg= param->get_compare_argument(&size);
+  if (init_queue(&queue, n_threads, 0, 0, cmp_sort_slices, &slice_cmp, 0, 0))
+  {
+    my_free(merged);
+    DBUG_RETURN(0);
+  }
+
+  ps.param= param;
+  ps.keys= keys;
+  ps.count= count;
+  ps.n_slices= n_threads;
+  /* The merge target doubles as the radix sort scratch area */
+  ps.buffer= (!param->using_packed_sortkeys() &&
+              radixsort_is_applicable(count / n_threads, size)) ?
+             merged : NULL;
+
+  sql_run_parallel(n_threads, sort_slice, &ps);
+
+  for (uint i= 0; i < n_threads; i++)
+  {
+    slices[i].pos= keys + ps.slice_start(i);
+    slices[i].end= keys + ps.slice_start(i + 1);
+    queue_insert(&queue, (uchar*) &slices[i]);
+  }
+
+  for (uchar **to= merged; !queue_empty(&queue); )
+  {
+    Sort_slice *slice= (Sort_slice*) queue_top(&queue);
+    *to++= *slice->pos;
+    if (++slice->pos == slice->end)
+      queue_remove_top(&queue);
+    else
+      queue_replace_top(&queue);
+  }
+
+  memcpy(keys, merged, count * sizeof(char*));
+  delete_queue(&queue);
+  my_free(merged);
+  DBUG_RETURN(n_threads);
+}
+
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return 1;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
 
+  if (!param->using_pq && param->sort_threads > 1)
+  {
+    uint n_threads= MY_MIN(param->sort_threads,
+                           count / MIN_KEYS_PER_SORT_THREAD);
+    set_if_smaller(n_threads, SQL_PARALLEL_MAX_TASKS);
+    if (n_threads > 1 &&
+        (n_threads= parallel_sort_key_pointers(param, m_sort_keys, count,
+                                               n_threads)))
+      return n_threads;
+  }
+
   uchar **buffer= NULL;
   if (!param->using_packed_sortkeys() &&
       radixsort_is_applicable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
                                    MYF(MY_THREAD_SPECIFIC))))
   {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
+    sort_key_pointers(param, m_sort_keys, count, buffer);
     my_free(buffer);
-    return;
+    return 1;
   }
 
-  my_qsort2(m_sort_keys, count, sizeof(uchar*),
-            param->get_compare_function(),
-            param->get_compare_argument(&size));
+  sort_key_pointers(param, m_sort_keys, count, NULL);
+  return 1;
 }
 
 
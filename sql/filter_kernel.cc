@@ -0,0 +1,386 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/**
+  @file
+  Compiled evaluation of simple conditions attached to a table,
+  see filter_kernel.h.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "item_cmpfunc.h"
+#include "compat56.h"          // my_datetime_packed_from_binary
+#include "sql_time.h"          // pack_time
+#include "filter_kernel.h"
+
+
+/*
+  Number of microseconds in a day, as used by pack_time().
+  A DATE value is packed as ((year * 13 + month) * 32 + day) days.
+*/
+#define FILTER_KERNEL_DAY_PACKED (24ULL * 60 * 60 * 1000000)
+
+
+Filter_kernel *Filter_kernel::create(THD *thd, TABLE *table, Item *cond)
+{
+  uint max_steps= 2;
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+    max_steps= 2 * ((Item_cond*) cond)->argument_list()->elements;
+
+  Step *steps= thd->alloc<Step>(max_steps);
+  if (!steps)
+    return NULL;
+  Filter_kernel *kernel= new (thd->mem_root)
+    Filter_kernel(table, cond, steps, max_steps);
+  if (!kernel)
+    return NULL;
+
+  cond->add_filter_kernel_step(thd, kernel);
+  return kernel->n_steps ? kernel : NULL;
+}
+
+
+/**
+  Prepare the next step for a column of the table.
+
+  @return the step, or NULL if the column cannot be read by the kernel
+*/
+
+Filter_kernel::Step *Filter_kernel::new_step(Item *field_item,
+                                             Compare_type type)
+{
+  if (n_steps == max_steps)
+    return NULL;
+
+  Item *real= field_item->real_item();
+  if (real->type() != Item::FIELD_ITEM)
+    return NULL;
+  Field *field= ((Item_field*) real)->field;
+  if (field->table != table)
+    return NULL;
+
+  Step *step= steps + n_steps;
+  const Type_handler *handler= field->type_handler();
+  step->field= field;
+  step->field_unsigned= false;
+  step->accept= 0;
+  step->int_values= NULL;
+  step->real_values= NULL;
+  step->n_values= 0;
+
+  switch (type) {
+  case COMPARE_INT:
+    if (handler == &type_handler_stiny || handler == &type_handler_sshort ||
+        handler == &type_handler_sint24 || handler == &type_handler_slong ||
+        handler == &type_handler_slonglong)
+      step->field_unsigned= false;
+    else if (handler == &type_handler_utiny ||
+             handler == &type_handler_ushort ||
+             handler == &type_handler_uint24 ||
+             handler == &type_handler_ulong ||
+             handler == &type_handler_ulonglong)
+      step->field_unsigned= true;
+    else
+      return NULL;
+    step->format= FORMAT_INT;
+    return step;
+  case COMPARE_REAL:
+    if (handler == &type_handler_double)
+      step->format= FORMAT_DOUBLE;
+    else if (handler == &type_handler_float)
+      step->format= FORMAT_FLOAT;
+    else
+      return NULL;
+    return step;
+  case COMPARE_DATETIME:
+    if (handler == &type_handler_newdate)
+      step->format= FORMAT_DATE;
+    else if (handler == &type_handler_datetime2)
+      step->format= FORMAT_DATETIME;
+    else
+      return NULL;
+    return step;
+  }
+  return NULL;
+}
+
+
+/**
+  Evaluate a constant in the representation used by a step.
+
+  Constants that are NULL, or that produce any warning when evaluated, are
+  not compiled: the warning must be raised by the regular evaluation.
+
+  @return TRUE if the constant cannot be used
+*/
+
+bool Filter_kernel::get_value(THD *thd, Item *item, Compare_type type,
+                              Step *step)
+{
+  if (!item->basic_const_item())
+    return true;
+
+  Dummy_error_handler error_handler;
+  thd->push_internal_handler(&error_handler);
+  switch (type) {
+  case COMPARE_INT:
+  {
+    Longlong_hybrid nr= item->to_longlong_hybrid();
+    step->int_value= nr.value();
+    step->int_value_unsigned= nr.is_unsigned();
+    break;
+  }
+  case COMPARE_REAL:
+    step->real_value= item->val_real();
+    break;
+  case COMPARE_DATETIME:
+    step->int_value= item->val_datetime_packed(thd);
+    step->int_value_unsigned= false;
+    break;
+  }
+  thd->pop_internal_handler();
+  return item->null_value || error_handler.any_error();
+}
+
+
+bool Filter_kernel::add_compare(THD *thd, Item *field_item, Item *value,
+                                uint accept, Compare_type type)
+{
+  Step *step= new_step(field_item, type);
+  if (!step || get_value(thd, value, type, step))
+    return true;
+  step->accept= accept;
+  n_steps++;
+  return false;
+}
+
+
+bool Filter_kernel::add_between(THD *thd, Item *field_item, Item *low,
+                                Item *high, Compare_type type)
+{
+  if (n_steps + 2 > max_steps)
+    return true;
+  if (add_compare(thd, field_item, low, CMP_EQ | CMP_GT, type))
+    return true;
+  if (add_compare(thd, field_item, high, CMP_LT | CMP_EQ, type))
+  {
+    n_steps--;
+    return true;
+  }
+  return false;
+}
+
+
+static int cmp_filter_kernel_signed(const void *a, const void *b)
+{
+  longlong x= *(const longlong*) a, y= *(const longlong*) b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+static int cmp_filter_kernel_unsigned(const void *a, const void *b)
+{
+  ulonglong x= *(const ulonglong*) a, y= *(const ulonglong*) b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+static int cmp_filter_kernel_real(const void *a, const void *b)
+{
+  double x= *(const double*) a, y= *(const double*) b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+/**
+  Add a step for field IN (values). The constants are stored sorted so that
+  the step can be checked with a binary search.
+
+  Integer constants are stored with the signedness of the column: the
+  constants outside of the range of the column can never match and are
+  left out.
+*/
+
+bool Filter_kernel::add_in(THD *thd, Item *field_item, Item **values,
+                           uint n_values, Compare_type type)
+{
+  Step *step= new_step(field_item, type);
+  if (!step)
+    return true;
+
+  bool real= type == COMPARE_REAL;
+  bool unsigned_values= type == COMPARE_INT && step->field_unsigned;
+  longlong *int_values= NULL;
+  double *real_values= NULL;
+  if (real ? !(real_values= thd->alloc<double>(n_values)) :
+             !(int_values= thd->alloc<longlong>(n_values)))
+    return true;
+
+  uint n= 0;
+  for (uint i= 0; i < n_values; i++)
+  {
+    Step value;
+    if (get_value(thd, values[i], type, &value))
+      return true;
+    if (real)
+      real_values[n++]= value.real_value;
+    else if (type == COMPARE_INT &&
+             value.int_value_unsigned != unsigned_values &&
+             value.int_value < 0)
+      continue;                                 // Out of the column range
+    else
+      int_values[n++]= value.int_value;
+  }
+
+  if (real)
+    my_qsort(real_values, n, sizeof(double), cmp_filter_kernel_real);
+  else
+    my_qsort(int_values, n, sizeof(longlong),
+             unsigned_values ? cmp_filter_kernel_unsigned :
+                               cmp_filter_kernel_signed);
+  step->int_values= int_values;
+  step->real_values= real_values;
+  step->int_value_unsigned= unsigned_values;
+  step->n_values= n;
+  n_steps++;
+  return false;
+}
+
+
+static inline int filter_kernel_cmp(longlong a, bool a_unsigned,
+                                    longlong b, bool b_unsigned)
+{
+  return Longlong_hybrid(a, a_unsigned).cmp(Longlong_hybrid(b, b_unsigned));
+}
+
+
+static bool filter_kernel_find(const longlong *values, uint n,
+                               longlong value, bool unsigned_values)
+{
+  uint low= 0, high= n;
+  while (low < high)
+  {
+    uint mid= (low + high) / 2;
+    int res= unsigned_values ?
+      ((ulonglong) values[mid] < (ulonglong) value ? -1 :
+       values[mid] == value ? 0 : 1) :
+      (values[mid] < value ? -1 : values[mid] == value ? 0 : 1);
+    if (res == 0)
+      return true;
+    if (res < 0)
+      low= mid + 1;
+    else
+      high= mid;
+  }
+  return false;
+}
+
+
+static bool filter_kernel_find(const double *values, uint n, double value)
+{
+  uint low= 0, high= n;
+  while (low < high)
+  {
+    uint mid= (low + high) / 2;
+    if (values[mid] == value)
+      return true;
+    if (values[mid] < value)
+      low= mid + 1;
+    else
+      high= mid;
+  }
+  return false;
+}
+
+
+int Filter_kernel::check_step(const Step *step) const
+{
+  const Field *field= step->field;
+  if (field->is_null())
+    return -1;
+
+  const uchar *ptr= field->ptr;
+  longlong nr;
+  int res;
+  switch (step->format) {
+  case FORMAT_INT:
+    switch (field->pack_length()) {
+    case 1:
+      nr= step->field_unsigned ? (longlong) ptr[0] : (longlong) (int8) ptr[0];
+      break;
+    case 2:
+      nr= step->field_unsigned ? (longlong) uint2korr(ptr) : sint2korr(ptr);
+      break;
+    case 3:
+      nr= step->field_unsigned ? (longlong) uint3korr(ptr) : sint3korr(ptr);
+      break;
+    case 4:
+      nr= step->field_unsigned ? (longlong) uint4korr(ptr) : sint4korr(ptr);
+      break;
+    default:
+      nr= sint8korr(ptr);
+      break;
+    }
+    if (step->int_values)
+      return !filter_kernel_find(step->int_values, step->n_values, nr,
+                                 step->int_value_unsigned);
+    res= filter_kernel_cmp(nr, step->field_unsigned,
+                           step->int_value, step->int_value_unsigned);
+    break;
+  case FORMAT_FLOAT:
+  case FORMAT_DOUBLE:
+  {
+    double value;
+    if (step->format == FORMAT_FLOAT)
+    {
+      float tmp;
+      float4get(tmp, ptr);
+      value= tmp;
+    }
+    else
+      float8get(value, ptr);
+    if (step->real_values)
+      return !filter_kernel_find(step->real_values, step->n_values, value);
+    res= value < step->real_value ? -1 : value == step->real_value ? 0 : 1;
+    break;
+  }
+  case FORMAT_DATE:
+  case FORMAT_DATETIME:
+    if (step->format == FORMAT_DATE)
+    {
+      uint32 tmp= (uint32) uint3korr(ptr);
+      nr= (longlong) (((tmp >> 9) * 13ULL + ((tmp >> 5) & 15)) * 32ULL +
+                      (tmp & 31)) * FILTER_KERNEL_DAY_PACKED;
+    }
+    else
+    {
+      MYSQL_TIME ltime;
+      TIME_from_longlong_datetime_packed(&ltime,
+        my_datetime_packed_from_binary(ptr, field->decimals()));
+      nr= pack_time(&ltime);
+    }
+    if (step->int_values)
+      return !filter_kernel_find(step->int_values, step->n_values, nr, false);
+    res= nr < step->int_value ? -1 : nr == step->int_value ? 0 : 1;
+    break;
+  default:
+    DBUG_ASSERT(0);
+    return -1;
+  }
+  return !(step->accept & (res < 0 ? CMP_LT : res == 0 ? CMP_EQ : CMP_GT));
+}
@@ -0,0 +1,155 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef FILTER_KERNEL_INCLUDED
+#define FILTER_KERNEL_INCLUDED
+
+/**
+  @file
+  Filter kernels: a compiled form of simple conditions attached to a table.
+
+  Evaluating the condition attached to a join table means calling
+  val_bool() recursively over the Item tree for every row that is read.
+  For the common predicates of the form
+
+    field <op> constant
+    field BETWEEN constant AND constant
+    field IN (constant, ...)
+
+  over integer, floating point, DATE and DATETIME columns most of this work
+  can be avoided: the constants are converted once into the representation
+  used for the comparison, and the column value is decoded straight from
+  the record buffer.
+
+  A filter kernel is built from the leading conjuncts of the condition that
+  have this form (see Item::add_filter_kernel_step()). It is only used to
+  reject rows early: when the kernel rejects a row, evaluating the condition
+  would have returned FALSE or NULL without evaluating any other conjunct.
+  Otherwise the condition is evaluated as usual. In particular, a NULL
+  column value stops the kernel because conjunctive conditions that are not
+  at the top level continue after NULL.
+*/
+
+#include "sql_type_int.h"
+
+class Field;
+class Item;
+class TABLE;
+class THD;
+
+class Filter_kernel: public Sql_alloc
+{
+public:
+  /* Bits for the outcomes of a comparison that satisfy a step */
+  static const uint CMP_LT= 1;
+  static const uint CMP_EQ= 2;
+  static const uint CMP_GT= 4;
+
+  /*
+    The comparison that a step performs. It corresponds to the
+    comparison type of the predicate the step has been built from.
+  */
+  enum Compare_type
+  {
+    COMPARE_INT,            // Longlong_hybrid values
+    COMPARE_REAL,           // double values
+    COMPARE_DATETIME        // values packed with pack_time()
+  };
+
+private:
+  /* How the value of the column is decoded from the record buffer */
+  enum Field_format
+  {
+    FORMAT_INT,             // little endian integer of 1 to 8 bytes
+    FORMAT_FLOAT,
+    FORMAT_DOUBLE,
+    FORMAT_DATE,            // Field_newdate
+    FORMAT_DATETIME         // Field_datetimef
+  };
+
+  struct Step
+  {
+    Field *field;
+    Field_format format;
+    bool field_unsigned;
+    /* Combination of CMP_XXX, used unless int_values or real_values is set */
+    uint accept;
+    longlong int_value;
+    bool int_value_unsigned;
+    double real_value;
+    /* Sorted constants of the IN list, or NULL */
+    longlong *int_values;
+    double *real_values;
+    uint n_values;
+  };
+
+  TABLE *table;
+  /* The condition the kernel has been built for */
+  Item *cond;
+  Step *steps;
+  uint n_steps;
+  uint max_steps;
+
+  Step *new_step(Item *field_item, Compare_type type);
+  bool get_value(THD *thd, Item *item, Compare_type type, Step *step);
+  /*
+    Returns 1 if the step rejects the row, 0 if the row satisfies the step
+    and -1 if the row cannot be checked by the kernel.
+  */
+  int check_step(const Step *step) const;
+
+  Filter_kernel(TABLE *table_arg, Item *cond_arg, Step *steps_arg,
+                uint max_steps_arg)
+    :table(table_arg), cond(cond_arg), steps(steps_arg), n_steps(0),
+     max_steps(max_steps_arg)
+  {}
+
+public:
+  /*
+    Build the kernel for the condition attached to table.
+    Returns NULL if no leading conjunct of the condition can be compiled.
+  */
+  static Filter_kernel *create(THD *thd, TABLE *table, Item *cond);
+
+  /*
+    Functions used by Item::add_filter_kernel_step() to add the next step.
+    They return TRUE if the predicate cannot be compiled, and then no
+    further steps are added.
+  */
+  bool add_compare(THD *thd, Item *field_item, Item *value, uint accept,
+                   Compare_type type);
+  bool add_between(THD *thd, Item *field_item, Item *low, Item *high,
+                   Compare_type type);
+  bool add_in(THD *thd, Item *field_item, Item **values, uint n_values,
+              Compare_type type);
+
+  Item *get_cond() const { return cond; }
+
+  /*
+    Check the row in the record buffer of the table.
+    Returns TRUE if the row is known not to satisfy the condition.
+  */
+  bool rejects() const
+  {
+    for (const Step *step= steps; step < steps + n_steps; step++)
+    {
+      if (int res= check_step(step))
+        return res > 0;
+    }
+    return false;
+  }
+};
+
+#endif /* FILTER_KERNEL_INCLUDED */
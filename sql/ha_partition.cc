@@ -10373,6 +10373,34 @@ ha_rows ha_partition::records()
 }
 
 
+/**
+  Exact number of rows in table for COUNT(*). see handler.h
+
+  @return Number of records in the table (after pruning!)
+*/
+
+ha_rows ha_partition::records_for_count()
+{
+  ha_rows tot_rows= 0;
+  uint i;
+  DBUG_ENTER("ha_partition::records_for_count");
+
+  for (i= bitmap_get_first_set(&m_part_info->read_partitions);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(&m_part_info->read_partitions, i))
+  {
+    if (unlikely(m_file[i]->pre_records()))
+      DBUG_RETURN(HA_POS_ERROR);
+    const ha_rows rows= m_file[i]->records_for_count();
+    if (unlikely(rows == HA_POS_ERROR))
+      DBUG_RETURN(HA_POS_ERROR);
+    tot_rows+= rows;
+  }
+  DBUG_PRINT("exit", ("records: %lld", (longlong) tot_rows));
+  DBUG_RETURN(tot_rows);
+}
+
+
 /*
   Is it ok to switch to a new engine for this table
 
@@ -1097,6 +1097,7 @@ class ha_partition final :public handler
   */
   uint8 table_cache_type() override;
   ha_rows records() override;
+  ha_rows records_for_count() override;
 
   /* Calculate hash value for PARTITION BY KEY tables. */
   static uint64 calculate_key_hash_value(Field **field_array);
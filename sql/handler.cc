@@ -7948,6 +7948,9 @@ static int binlog_log_row_to_binlog(TABLE* table,
     error= (*log_func)(thd, table, mysql_bin_log.as_event_log(), cache,
                        has_trans, thd->variables.binlog_row_image,
                        before_record, after_record);
+  if (!error && opt_binlog_transaction_dependency_tracking ==
+      BINLOG_DEPENDENCY_TRACKING_WRITESET)
+    binlog_writeset_add_row(cache_mngr, table, before_record, after_record);
   DBUG_RETURN(error ? HA_ERR_RBR_LOGGING_FAILED : 0);
 }
 
@@ -4240,6 +4240,15 @@ class handler :public Sql_alloc
   */
   virtual int pre_records() { return 0; }
   virtual ha_rows records() { return stats.records; }
+  /**
+    Exact number of rows in the table, for COUNT(*) without a WHERE clause.
+    It will only be called by opt_sum_query() if
+    (table_flags() & HA_HAS_RECORDS) != 0, and not for EXPLAIN.
+    Engines whose records() is only an estimate can count the rows here.
+
+    @retval HA_POS_ERROR if the rows must be counted by a table scan
+  */
+  virtual ha_rows records_for_count() { return records(); }
   /**
     Return upper bound of current number of records in the table
     (max. of how many records one will retrieve when doing a full table scan)
@@ -130,6 +130,7 @@ class Item_param;
 class user_var_entry;
 class JOIN;
 struct KEY_FIELD;
+class Filter_kernel;
 struct SARGABLE_PARAM;
 class RANGE_OPT_PARAM;
 class SEL_TREE;
@@ -2106,6 +2107,14 @@ class Item :public Value_source,
                               SARGABLE_PARAM **sargables)
   {
     return;
+  }
+  /*
+    Add the compiled form of this condition to a filter kernel,
+    see filter_kernel.h. Returns TRUE if the condition cannot be compiled.
+  */
+  virtual bool add_filter_kernel_step(THD *thd, Filter_kernel *kernel)
+  {
+    return true;
   }
    /*
      Make a select tree for all keys in a condition or a condition part
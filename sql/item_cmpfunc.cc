@@ -32,6 +32,7 @@
 #define PCRE2_STATIC 1             /* Important on Windows */
 #include "pcre2.h"                 /* pcre2 header file */
 #include "my_json_writer.h"
+#include "filter_kernel.h"
 
 /*
   Compare row signature of two expressions
@@ -8128,3 +8129,105 @@ Item *Item_equal::multiple_equality_transformer(THD *thd, uchar *arg)
   }
 }
 
+
+
+/*
+  Get the comparison of a filter kernel step for the data type handler
+  that BETWEEN and IN use to compare their arguments.
+
+  @retval TRUE   the comparison cannot be compiled
+*/
+
+static bool filter_kernel_compare_type(const Type_handler *handler,
+                                       Filter_kernel::Compare_type *type)
+{
+  switch (handler->cmp_type()) {
+  case INT_RESULT:
+    *type= Filter_kernel::COMPARE_INT;
+    return false;
+  case REAL_RESULT:
+    *type= Filter_kernel::COMPARE_REAL;
+    return false;
+  case TIME_RESULT:
+    if (handler->is_timestamp_type() ||
+        (handler->mysql_timestamp_type() != MYSQL_TIMESTAMP_DATE &&
+         handler->mysql_timestamp_type() != MYSQL_TIMESTAMP_DATETIME))
+      return true;
+    *type= Filter_kernel::COMPARE_DATETIME;
+    return false;
+  default:
+    return true;
+  }
+}
+
+
+bool Item_bool_rowready_func2::add_filter_kernel_step(THD *thd,
+                                                      Filter_kernel *kernel)
+{
+  Filter_kernel::Compare_type type;
+  if (cmp.func == &Arg_comparator::compare_int_signed ||
+      cmp.func == &Arg_comparator::compare_int_signed_unsigned ||
+      cmp.func == &Arg_comparator::compare_int_unsigned_signed ||
+      cmp.func == &Arg_comparator::compare_int_unsigned)
+    type= Filter_kernel::COMPARE_INT;
+  else if (cmp.func == &Arg_comparator::compare_real)
+    type= Filter_kernel::COMPARE_REAL;
+  else if (cmp.func == &Arg_comparator::compare_datetime)
+    type= Filter_kernel::COMPARE_DATETIME;
+  else
+    return true;
+
+  uint accept;
+  switch (functype()) {
+  case EQ_FUNC: accept= Filter_kernel::CMP_EQ; break;
+  case NE_FUNC: accept= Filter_kernel::CMP_LT | Filter_kernel::CMP_GT; break;
+  case LT_FUNC: accept= Filter_kernel::CMP_LT; break;
+  case LE_FUNC: accept= Filter_kernel::CMP_LT | Filter_kernel::CMP_EQ; break;
+  case GT_FUNC: accept= Filter_kernel::CMP_GT; break;
+  case GE_FUNC: accept= Filter_kernel::CMP_GT | Filter_kernel::CMP_EQ; break;
+  default:
+    return true;
+  }
+
+  if (args[1]->basic_const_item())
+    return kernel->add_compare(thd, args[0], args[1], accept, type);
+
+  /* constant <op> field: swap the outcomes of the comparison */
+  accept= (accept & Filter_kernel::CMP_EQ) |
+          (accept & Filter_kernel::CMP_LT ? Filter_kernel::CMP_GT : 0) |
+          (accept & Filter_kernel::CMP_GT ? Filter_kernel::CMP_LT : 0);
+  return kernel->add_compare(thd, args[1], args[0], accept, type);
+}
+
+
+bool Item_func_between::add_filter_kernel_step(THD *thd,
+                                               Filter_kernel *kernel)
+{
+  Filter_kernel::Compare_type type;
+  if (negated || filter_kernel_compare_type(m_comparator.type_handler(), &type))
+    return true;
+  return kernel->add_between(thd, args[0], args[1], args[2], type);
+}
+
+
+bool Item_func_in::add_filter_kernel_step(THD *thd, Filter_kernel *kernel)
+{
+  Filter_kernel::Compare_type type;
+  if (negated || !array ||
+      filter_kernel_compare_type(m_comparator.type_handler(), &type))
+    return true;
+  return kernel->add_in(thd, args[0], args + 1, arg_count - 1, type);
+}
+
+
+bool Item_cond_and::add_filter_kernel_step(THD *thd, Filter_kernel *kernel)
+{
+  List_iterator_fast<Item> li(list);
+  Item *item;
+  while ((item= li++))
+  {
+    if (item->add_filter_kernel_step(thd, kernel))
+      return true;
+  }
+  return false;
+}
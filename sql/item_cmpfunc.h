@@ -669,6 +669,7 @@ class Item_bool_rowready_func2 :public Item_bool_func2_with_rev
     return add_key_fields_optimize_op(join, key_fields, and_level,
                                       usable_tables, sargables, false);
   }
+  bool add_filter_kernel_step(THD *thd, Filter_kernel *kernel) override;
   Item *deep_copy(THD *thd) const override
   {
     Item_bool_rowready_func2 *clone=
@@ -1147,6 +1148,7 @@ class Item_func_between :public Item_func_opt_neg
   void add_key_fields(JOIN *join, KEY_FIELD **key_fields,
                       uint *and_level, table_map usable_tables,
                       SARGABLE_PARAM **sargables) override;
+  bool add_filter_kernel_step(THD *thd, Filter_kernel *kernel) override;
   SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr) override;
   Item* propagate_equal_fields(THD *thd, const Context &ctx, COND_EQUAL *cond)
     override
@@ -2764,6 +2766,7 @@ class Item_func_in :public Item_func_opt_neg,
   void add_key_fields(JOIN *join, KEY_FIELD **key_fields, uint *and_level,
                       table_map usable_tables, SARGABLE_PARAM **sargables)
     override;
+  bool add_filter_kernel_step(THD *thd, Filter_kernel *kernel) override;
   SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr) override;
   SEL_TREE *get_func_row_mm_tree(RANGE_OPT_PARAM *param, Item_row *key_row); 
   Item* propagate_equal_fields(THD *thd, const Context &ctx, COND_EQUAL *cond)
@@ -3809,6 +3812,7 @@ class Item_cond_and final :public Item_cond
   void add_key_fields(JOIN *join, KEY_FIELD **key_fields, uint *and_level,
                       table_map usable_tables, SARGABLE_PARAM **sargables)
     override;
+  bool add_filter_kernel_step(THD *thd, Filter_kernel *kernel) override;
   SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr) override;
 
 protected:
@@ -134,6 +134,9 @@ static ulonglong binlog_status_var_num_group_commits;
 static ulonglong binlog_status_group_commit_trigger_count;
 static ulonglong binlog_status_group_commit_trigger_lock_wait;
 static ulonglong binlog_status_group_commit_trigger_timeout;
+static ulonglong binlog_status_commit_latency_p50;
+static ulonglong binlog_status_commit_latency_p95;
+static ulonglong binlog_status_commit_latency_p99;
 static char binlog_snapshot_file[FN_REFLEN];
 static ulonglong binlog_snapshot_position;
 static constexpr size_t BINLOG_SPILL_MAX= 512 * 1024;
@@ -148,6 +151,12 @@ static const char *fatal_log_error=
 
 static SHOW_VAR binlog_status_vars_detail[]=
 {
+  {"commit_latency_p50",
+    (char *)&binlog_status_commit_latency_p50, SHOW_LONGLONG},
+  {"commit_latency_p95",
+    (char *)&binlog_status_commit_latency_p95, SHOW_LONGLONG},
+  {"commit_latency_p99",
+    (char *)&binlog_status_commit_latency_p99, SHOW_LONGLONG},
   {"commits",
     (char *)&binlog_status_var_num_commits, SHOW_LONGLONG},
   {"group_commits",
@@ -512,7 +521,8 @@ class binlog_cache_mngr {
       cache_savepoint_next_ptr(&cache_savepoint_list),
       using_stmt_cache(FALSE), using_trx_cache(FALSE),
       using_xa(FALSE), xa_xid(0),
-      engine_binlogged(FALSE), need_write_direct(FALSE)
+      engine_binlogged(FALSE), need_write_direct(FALSE),
+      writeset(key_memory_binlog_cache_mngr, 0, 64), writeset_unsafe(FALSE)
   {
      stmt_cache.set_binlog_cache_info(param_max_binlog_stmt_cache_size,
                                       param_ptr_binlog_stmt_cache_use,
@@ -569,6 +579,11 @@ class binlog_cache_mngr {
       using_trx_cache= FALSE;
       using_xa= FALSE;
     }
+    if (do_trx || (do_stmt && trx_cache.empty()))
+    {
+      writeset.clear();
+      writeset_unsafe= FALSE;
+    }
     engine_binlogged= FALSE;
     need_write_direct= FALSE;
     /*
@@ -698,12 +713,164 @@ class binlog_cache_mngr {
   //Will be reset when gtid is written into binlog
   uchar  gtid_flags3;
   decltype (rpl_gtid::seq_no) sa_seq_no;
+
+  /*
+    Hashes of the unique keys of the rows that were logged in the
+    transaction, for binlog_transaction_dependency_tracking=WRITESET.
+  */
+  Dynamic_array<uint64> writeset;
+  /*
+    Set when the transaction changed something that writeset does not
+    identify (a statement, or a table without a primary key), so that the
+    event group must depend on the preceding one.
+  */
+  bool writeset_unsafe;
 private:
 
   binlog_cache_mngr& operator=(const binlog_cache_mngr& info);
   binlog_cache_mngr(const binlog_cache_mngr& info);
 };
 
+/*
+  The history for binlog_transaction_dependency_tracking=WRITESET.
+
+  For each row hash, the last event group (domain_id and seq_no) that
+  modified the row is remembered. An event group depends on the largest
+  seq_no that is found for its writeset, but at least on the low_water of
+  its domain, which covers the rows that were evicted from the history as
+  well as the event groups whose writeset is not known.
+
+  GTIDs are allocated in binlog order while holding LOCK_log, which also
+  protects this object.
+*/
+class Binlog_writeset_history
+{
+  struct row
+  {
+    uint64 hash;
+    uint64 seq_no;
+    uint32 domain_id;
+  };
+  struct domain
+  {
+    uint32 domain_id;
+    /* seq_no of the last event group in the domain */
+    uint64 last_seq_no;
+    /* seq_no that every following event group in the domain depends on */
+    uint64 low_water;
+  };
+  /* Number of replication domains that are tracked at a time */
+  static constexpr uint N_DOMAINS= 16;
+
+  row *rows= nullptr;
+  size_t n_rows= 0;
+  domain domains[N_DOMAINS];
+  uint n_domains= 0;
+  /* The element of domains[] to replace when all are in use */
+  uint next_domain= 0;
+
+  domain *find_domain(uint32 domain_id)
+  {
+    for (uint i= 0; i < n_domains; i++)
+      if (domains[i].domain_id == domain_id)
+        return &domains[i];
+    return nullptr;
+  }
+
+public:
+  void free()
+  {
+    my_free(rows);
+    rows= nullptr;
+    n_rows= 0;
+    n_domains= 0;
+  }
+
+  /**
+    Compute the dependency of an event group and record its writeset.
+
+    @param domain_id   GTID domain of the event group
+    @param seq_no      GTID sequence number of the event group
+    @param writeset    hashes of the modified rows, or NULL if the event
+                       group must depend on the preceding one
+    @param dependency  set to the seq_no that the event group depends on
+
+    @return whether the dependency could be determined
+  */
+  bool add(uint32 domain_id, uint64 seq_no,
+           const Dynamic_array<uint64> *writeset, uint64 *dependency)
+  {
+    mysql_mutex_assert_owner(mysql_bin_log.get_log_lock());
+
+    const size_t size= opt_binlog_transaction_dependency_history_size;
+    if (n_rows != size)
+    {
+      free();
+      if (!(rows= (row *) my_malloc(key_memory_binlog_cache_mngr,
+                                    size * sizeof *rows, MYF(MY_ZEROFILL))))
+        return false;
+      n_rows= size;
+    }
+
+    domain *d= find_domain(domain_id);
+    if (!d || seq_no <= d->last_seq_no)
+    {
+      if (d)
+      {
+        /* The sequence numbers went backwards; forget everything. */
+        bzero(rows, n_rows * sizeof *rows);
+        n_domains= 0;
+      }
+      if (n_domains < N_DOMAINS)
+        d= &domains[n_domains++];
+      else
+      {
+        d= &domains[next_domain];
+        next_domain= (next_domain + 1) % N_DOMAINS;
+      }
+      d->domain_id= domain_id;
+      d->last_seq_no= d->low_water= seq_no;
+      return false;
+    }
+
+    uint64 dep= d->low_water;
+    if (!writeset)
+    {
+      dep= d->last_seq_no;
+      d->low_water= seq_no;
+    }
+    else
+    {
+      for (size_t i= 0; i < writeset->elements(); i++)
+      {
+        const row &r= rows[writeset->at(i) % n_rows];
+        if (r.hash == writeset->at(i) && r.domain_id == domain_id &&
+            r.seq_no > dep)
+          dep= r.seq_no;
+      }
+      for (size_t i= 0; i < writeset->elements(); i++)
+      {
+        row &r= rows[writeset->at(i) % n_rows];
+        if (r.seq_no && (r.hash != writeset->at(i) || r.domain_id != domain_id))
+        {
+          /* Evict the row; its event group becomes the low water mark. */
+          domain *e= find_domain(r.domain_id);
+          if (e && e->low_water < r.seq_no)
+            e->low_water= r.seq_no;
+        }
+        r.hash= writeset->at(i);
+        r.seq_no= seq_no;
+        r.domain_id= domain_id;
+      }
+    }
+    d->last_seq_no= seq_no;
+    *dependency= dep;
+    return true;
+  }
+};
+
+static Binlog_writeset_history binlog_writeset_history;
+
 /**
   The function handles the first phase of two-phase binlogged ALTER.
   On master binlogs START ALTER when that is configured to do so.
@@ -4363,7 +4530,9 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    group_commit_queue(0), group_commit_queue_busy(FALSE),
    num_commits(0), num_group_commits(0),
    group_commit_trigger_count(0), group_commit_trigger_timeout(0),
-   group_commit_trigger_lock_wait(0), gtid_index(nullptr),
+   group_commit_trigger_lock_wait(0), sync_usec_avg(0),
+   commit_interval_usec_avg(0), last_commit_queue_time(0), commit_latency(),
+   gtid_index(nullptr),
    sync_period_ptr(sync_period), sync_counter(0),
    state_file_deleted(false), binlog_state_recover_done(false),
    is_relay_log(0), relay_signal_cnt(0),
@@ -4438,6 +4607,8 @@ void MYSQL_BIN_LOG::cleanup()
       delete b;
     }
 
+    if (!is_relay_log)
+      binlog_writeset_history.free();
     mysql_mutex_destroy(&LOCK_log);
     mysql_mutex_destroy(&LOCK_index);
     mysql_mutex_destroy(&LOCK_binlog_use);
@@ -7158,12 +7329,14 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
   DBUG_RETURN(error);
 }
 
-bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
+bool MYSQL_BIN_LOG::flush_and_sync(bool *synced, bool *sync_due)
 {
   DBUG_ASSERT(is_relay_log || !opt_binlog_engine_hton);
   int err=0, fd=log_file.file;
   if (synced)
     *synced= 0;
+  if (sync_due)
+    *sync_due= 0;
   mysql_mutex_assert_owner(&LOCK_log);
   if (flush_io_cache(&log_file))
     return 1;
@@ -7171,6 +7344,12 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   if (sync_period && ++sync_counter >= sync_period)
   {
     sync_counter= 0;
+    if (sync_due)
+    {
+      *sync_due= 1;
+      return 0;
+    }
+    ulonglong start= microsecond_interval_timer();
     err= mysql_file_sync(fd, MYF(MY_WME));
     if (synced)
       *synced= 1;
@@ -7178,10 +7357,25 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
     if (opt_binlog_dbug_fsync_sleep > 0)
       my_sleep(opt_binlog_dbug_fsync_sleep);
 #endif
+    if (!is_relay_log)
+      note_sync_time(microsecond_interval_timer() - start);
   }
   return err;
 }
 
+
+/*
+  Update the moving average of the time it takes to sync the binlog file.
+  A sync may run outside of LOCK_log, so the update is not atomic; an
+  occasionally lost sample does not matter for an estimate.
+*/
+void MYSQL_BIN_LOG::note_sync_time(ulonglong usec)
+{
+  longlong avg= (longlong) sync_usec_avg.load(std::memory_order_relaxed);
+  avg= avg ? avg + ((longlong) usec - avg) / 8 : (longlong) usec;
+  sync_usec_avg.store((ulonglong) avg, std::memory_order_relaxed);
+}
+
 void MYSQL_BIN_LOG::start_union_events(THD *thd, query_id_t query_id_param)
 {
   DBUG_ASSERT(!thd->binlog_evt_union.do_union);
@@ -8046,6 +8240,89 @@ binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
   return cache_mngr->get_binlog_cache_data(use_trans_cache);
 }
 
+/**
+  Add the hashes of the unique keys of a logged row to the writeset of the
+  transaction (binlog_transaction_dependency_tracking=WRITESET).
+
+  @param cache_mngr     binlog cache manager of the transaction
+  @param table          the modified table
+  @param before_record  before image of the row, or NULL for an insert
+  @param after_record   after image of the row, or NULL for a delete
+*/
+void binlog_writeset_add_row(binlog_cache_mngr *cache_mngr, TABLE *table,
+                             const uchar *before_record,
+                             const uchar *after_record)
+{
+  if (cache_mngr->writeset_unsafe)
+    return;
+
+  TABLE_SHARE *share= table->s;
+  /*
+    Without a primary key we cannot tell which rows conflict, and changes
+    done by cascading foreign keys are not logged as rows.
+  */
+  if (share->primary_key == MAX_KEY ||
+      table->file->referenced_by_foreign_key())
+  {
+    cache_mngr->writeset_unsafe= TRUE;
+    return;
+  }
+
+  for (const uchar *record : {before_record, after_record})
+  {
+    if (!record)
+      continue;
+    const my_ptrdiff_t offset= record - table->record[0];
+
+    for (uint k= 0; k < share->keys; k++)
+    {
+      const KEY *key= &share->key_info[k];
+      if (!(key->flags & HA_NOSAME))
+        continue;
+
+      Hasher hasher(my_hasher_xxh3());
+      hasher.add(&my_charset_bin, share->table_cache_key.str,
+                 share->table_cache_key.length);
+      hasher.add(&my_charset_bin, (const uchar *) &k, sizeof k);
+
+      uint part= 0;
+      for (; part < key->user_defined_key_parts; part++)
+      {
+        Field *field= table->field[key->key_part[part].fieldnr - 1];
+        /*
+          A key that the statement did not read cannot have been changed,
+          and NULL values never conflict.
+        */
+        if ((!bitmap_is_set(table->read_set, field->field_index) &&
+             !bitmap_is_set(table->write_set, field->field_index)) ||
+            field->is_null(offset))
+          break;
+        field->move_field_offset(offset);
+        field->hash_not_null(&hasher);
+        field->move_field_offset(-offset);
+      }
+
+      if (part < key->user_defined_key_parts)
+      {
+        if (k == share->primary_key)
+        {
+          cache_mngr->writeset_unsafe= TRUE;
+          return;
+        }
+        continue;
+      }
+
+      if (cache_mngr->writeset.elements() >=
+          opt_binlog_transaction_dependency_history_size ||
+          cache_mngr->writeset.append(hasher.finalize()))
+      {
+        cache_mngr->writeset_unsafe= TRUE;
+        return;
+      }
+    }
+  }
+}
+
 int binlog_flush_pending_rows_event(THD *thd, bool stmt_end,
                                     bool is_transactional,
                                     Event_log *bin_log,
@@ -8379,6 +8656,30 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, binlog_cache_data *cache_data,
   Gtid_log_event gtid_event(thd, seq_no, domain_id, standalone, cache_type,
                             LOG_EVENT_SUPPRESS_USE_F, is_transactional,
                             commit_id, has_xid, is_ro_1pc);
+
+  if (opt_binlog_transaction_dependency_tracking ==
+      BINLOG_DEPENDENCY_TRACKING_WRITESET)
+  {
+    /*
+      Statements, DDL, XA and non-transactional changes are not covered by
+      the writeset; make them depend on the preceding event group.
+    */
+    binlog_cache_mngr *cache_mngr= thd->binlog_get_cache_mngr();
+    const bool known= cache_mngr && !cache_mngr->writeset_unsafe &&
+      (gtid_event.flags2 & Gtid_log_event::FL_TRANSACTIONAL) &&
+      !(gtid_event.flags2 & (Gtid_log_event::FL_DDL |
+                             Gtid_log_event::FL_PREPARED_XA |
+                             Gtid_log_event::FL_COMPLETED_XA));
+    uint64 dependency;
+    if (binlog_writeset_history.add(domain_id, seq_no,
+                                    known ? &cache_mngr->writeset : nullptr,
+                                    &dependency))
+    {
+      gtid_event.flags_extra|= Gtid_log_event::FL_EXTRA_DEPENDENCY;
+      gtid_event.dependency= dependency;
+    }
+  }
+
   /*
     Check that any binlogging during DDL recovery preserves the FL_DLL flag
     on the GTID event.
@@ -8846,6 +9147,11 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       if (thd->lex->stmt_accessed_non_trans_temp_table() && is_trans_cache)
         thd->transaction->stmt.mark_modified_non_trans_temp_table();
       thd->binlog_start_trans_and_stmt();
+      /* The changes made by a statement are not known by row. */
+      if (event_info->get_type_code() == QUERY_EVENT &&
+          thd->lex->sql_command != SQLCOM_SAVEPOINT &&
+          thd->lex->sql_command != SQLCOM_ROLLBACK_TO_SAVEPOINT)
+        cache_mngr->writeset_unsafe= TRUE;
     }
     DBUG_PRINT("info",("event type: %d",event_info->get_type_code()));
 
@@ -10116,6 +10422,7 @@ MYSQL_BIN_LOG::write_transaction_to_binlog(THD *thd,
   ha_info= all ? thd->transaction->all.ha_list : thd->transaction->stmt.ha_list;
   entry.ro_1pc= is_ro_1pc;
   entry.do_binlog_group_commit_ordered= false;
+  entry.queue_time= 0;
   entry.end_event= end_ev;
   cache_mngr->using_stmt_cache= using_stmt_cache;
   cache_mngr->using_trx_cache= using_trx_cache;
@@ -10208,6 +10515,7 @@ MYSQL_BIN_LOG::queue_for_group_commit(group_commit_entry *orig_entry)
   wait_for_commit *wfc;
   bool backup_lock_released= 0;
   int result= 0;
+  ulonglong now;
   THD *thd= orig_entry->thd;
   DBUG_ENTER("MYSQL_BIN_LOG::queue_for_group_commit");
   DBUG_ASSERT(thd == current_thd);
@@ -10346,6 +10654,7 @@ MYSQL_BIN_LOG::queue_for_group_commit(group_commit_entry *orig_entry)
   orig_entry->thd->clear_wakeup_ready();
   mysql_mutex_lock(&LOCK_prepare_ordered);
   orig_queue= group_commit_queue;
+  now= microsecond_interval_timer();
 
   /*
     Iteratively process everything added to the queue, looking for waiters,
@@ -10477,6 +10786,21 @@ MYSQL_BIN_LOG::queue_for_group_commit(group_commit_entry *orig_entry)
     */
     entry->thd->waiting_on_group_commit= true;
 
+    /*
+      Track the commit arrival rate for binlog_commit_wait_adaptive. An
+      interval longer than the longest group commit delay counts as that
+      delay, so that the average recovers quickly after the server was idle.
+    */
+    entry->queue_time= now;
+    if (last_commit_queue_time)
+    {
+      longlong interval= (longlong) std::min<ulonglong>
+        (now - last_commit_queue_time, opt_binlog_commit_wait_usec);
+      longlong avg= (longlong) commit_interval_usec_avg;
+      commit_interval_usec_avg= (ulonglong) (avg + (interval - avg) / 8);
+    }
+    last_commit_queue_time= now;
+
     /* Add the entry to the group commit queue. */
     next_entry= entry->next;
     entry->next= group_commit_queue;
@@ -10606,6 +10930,8 @@ MYSQL_BIN_LOG::write_transaction_with_group_commit(group_commit_entry *entry)
 
     DEBUG_SYNC(entry->thd, "commit_loop_entry_commit_ordered");
     ++num_commits;
+    if (entry->queue_time)
+      commit_latency.add(microsecond_interval_timer() - entry->queue_time);
     if (cache_mngr->using_xa && !entry->error)
       run_commit_ordered(entry->thd, entry->all);
 
@@ -10802,6 +11128,9 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
   ulong UNINIT_VAR(binlog_id);
   my_off_t UNINIT_VAR(commit_offset);
   group_commit_entry *current;
+  bool sync_due= false;
+  File UNINIT_VAR(sync_fd);
+  my_off_t UNINIT_VAR(sync_offset);
 
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_with_engines");
   mysql_mutex_assert_owner(&LOCK_log);
@@ -10884,8 +11213,22 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
     }
     set_current_thd(leader->thd);
 
+    /*
+      Sync the binlog only after LOCK_log is released, so that the next group
+      commit can write its transactions while this one waits for the disk.
+      This is not done when the file is about to be rotated, as it is closed
+      under LOCK_log, nor with semi-sync, whose after_flush hook must see the
+      binlog_end_pos update happen under LOCK_log.
+    */
+    bool defer_sync= !opt_binlog_engine_hton && !commit_by_rotate &&
+      my_b_write_tell(&log_file) < max_size
+#ifdef HAVE_REPLICATION
+      && !repl_semisync_master.get_master_enabled()
+#endif
+      ;
     bool synced= 0;
-    if (!opt_binlog_engine_hton && unlikely(flush_and_sync(&synced)))
+    if (!opt_binlog_engine_hton &&
+        unlikely(flush_and_sync(&synced, defer_sync ? &sync_due : NULL)))
     {
       for (current= leader; current != NULL; current= current->next)
       {
@@ -10956,7 +11299,12 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
         When --binlog-storage-engine, the binlog write happens during
         commit_ordered(), so postpone the update until then.
       */
-      if (!opt_binlog_engine_hton)
+      if (sync_due)
+      {
+        sync_fd= log_file.file;
+        sync_offset= commit_offset;
+      }
+      else if (!opt_binlog_engine_hton)
         update_binlog_end_pos(commit_offset);
     }
 
@@ -11009,6 +11357,36 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
 
   DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
+  if (sync_due)
+  {
+    /*
+      The next group commit may be writing to the file meanwhile. It cannot
+      close the file (see close()) until we release LOCK_after_binlog_sync.
+    */
+    ulonglong start= microsecond_interval_timer();
+    if (unlikely(mysql_file_sync(sync_fd, MYF(MY_WME))))
+    {
+      for (current= leader; current != NULL; current= current->next)
+      {
+        if (!current->error)
+        {
+          current->error= ER_ERROR_ON_WRITE;
+          current->commit_errno= errno;
+          current->error_cache= NULL;
+        }
+      }
+    }
+    else
+    {
+#ifndef DBUG_OFF
+      if (opt_binlog_dbug_fsync_sleep > 0)
+        my_sleep(opt_binlog_dbug_fsync_sleep);
+#endif
+      update_binlog_end_pos_after_sync(sync_offset);
+    }
+    note_sync_time(microsecond_interval_timer() - start);
+  }
+
 #ifdef HAVE_REPLICATION
   /*
     Loop through threads and run the binlog_sync hook
@@ -11092,6 +11470,7 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
     commit_ordered() methods for any transactions doing 2-phase commit.
   */
   current= leader;
+  ulonglong commit_time= microsecond_interval_timer();
   while (current != NULL)
   {
     group_commit_entry *next;
@@ -11100,6 +11479,8 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
     DEBUG_SYNC(leader->thd, "commit_loop_entry_commit_ordered");
     cache_mngr->engine_binlogged= FALSE;
     ++num_commits;
+    if (current->queue_time)
+      commit_latency.add(commit_time - current->queue_time);
     set_current_thd(current->thd);
     if (cache_mngr->using_xa && likely(!current->error) &&
         !DBUG_IF("skip_commit_ordered"))
@@ -11349,6 +11730,34 @@ int MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
 }
 
 
+/*
+  Choose the group commit delay for binlog_commit_wait_adaptive from the
+  observed binlog sync time and commit arrival rate, with the values of
+  binlog_commit_wait_count and binlog_commit_wait_usec as upper limits.
+
+  Waiting only pays off if more commits can be expected to queue up within
+  the time of one sync; otherwise it just adds latency, and *count is set to
+  zero to not wait at all.
+*/
+
+void
+MYSQL_BIN_LOG::adapt_commit_wait(ulong *count, ulong *usec)
+{
+  mysql_mutex_assert_owner(&LOCK_prepare_ordered);
+  ulonglong sync= sync_usec_avg.load(std::memory_order_relaxed);
+  ulonglong interval= commit_interval_usec_avg;
+
+  if (!sync || interval >= sync)
+  {
+    *count= 0;
+    return;
+  }
+  if (interval)
+    *count= (ulong) std::min<ulonglong>(*count, sync / interval + 1);
+  *usec= (ulong) std::min<ulonglong>(*usec, sync);
+}
+
+
 /*
   Wait for sufficient commits to queue up for group commit, according to the
   values of binlog_commit_wait_count and binlog_commit_wait_usec.
@@ -11364,13 +11773,22 @@ MYSQL_BIN_LOG::wait_for_sufficient_commits()
   group_commit_entry *e;
   group_commit_entry *last_head;
   struct timespec wait_until;
+  ulong wait_count= opt_binlog_commit_wait_count;
+  ulong wait_usec= opt_binlog_commit_wait_usec;
 
   mysql_mutex_assert_owner(&LOCK_log);
   mysql_mutex_assert_owner(&LOCK_prepare_ordered);
 
+  if (opt_binlog_commit_wait_adaptive)
+  {
+    adapt_commit_wait(&wait_count, &wait_usec);
+    if (wait_count <= 1)
+      return;
+  }
+
   for (e= last_head= group_commit_queue, count= 0; e; e= e->next)
   {
-    if (++count >= opt_binlog_commit_wait_count)
+    if (++count >= wait_count)
     {
       group_commit_trigger_count++;
       return;
@@ -11383,7 +11801,7 @@ MYSQL_BIN_LOG::wait_for_sufficient_commits()
   }
 
   mysql_mutex_unlock(&LOCK_log);
-  set_timespec_nsec(wait_until, (ulonglong)1000*opt_binlog_commit_wait_usec);
+  set_timespec_nsec(wait_until, (ulonglong)1000*wait_usec);
 
   for (;;)
   {
@@ -11412,7 +11830,7 @@ MYSQL_BIN_LOG::wait_for_sufficient_commits()
         goto after_loop;
       }
     }
-    if (count >= opt_binlog_commit_wait_count)
+    if (count >= wait_count)
     {
       group_commit_trigger_count++;
       break;
@@ -11567,6 +11985,15 @@ void MYSQL_BIN_LOG::close(uint exiting)
   if (log_state == LOG_OPENED)
   {
     DBUG_ASSERT(log_type == LOG_BIN);
+    if (!is_relay_log)
+    {
+      /*
+        The last group commit may still be syncing the file after releasing
+        LOCK_log; it holds LOCK_after_binlog_sync until the sync is done.
+      */
+      mysql_mutex_lock(&LOCK_after_binlog_sync);
+      mysql_mutex_unlock(&LOCK_after_binlog_sync);
+    }
 #ifdef HAVE_REPLICATION
     if (exiting & LOG_CLOSE_STOP_EVENT)
     {
@@ -14887,6 +15314,9 @@ TC_LOG_BINLOG::set_status_variables(THD *thd)
   mysql_mutex_lock(&LOCK_commit_ordered);
   binlog_status_var_num_commits= this->num_commits;
   binlog_status_var_num_group_commits= this->num_group_commits;
+  binlog_status_commit_latency_p50= commit_latency.percentile(50);
+  binlog_status_commit_latency_p95= commit_latency.percentile(95);
+  binlog_status_commit_latency_p99= commit_latency.percentile(99);
   if (!have_snapshot)
   {
     if (opt_binlog_engine_hton)
@@ -625,6 +625,46 @@ struct wait_for_commit;
 class Binlog_commit_by_rotate;
 struct rpl_binlog_state_base;
 
+/*
+  Histogram of binlog commit latencies, in microseconds, used to compute the
+  Binlog_commit_latency_pNN status variables. Values are counted in buckets
+  of four per power of two, so a percentile is exact to within 25%.
+*/
+struct Binlog_commit_latency_histogram
+{
+  static constexpr uint BUCKETS= 4 * 40;
+  ulonglong counts[BUCKETS];
+  ulonglong total;
+
+  static uint bucket(ulonglong usec)
+  {
+    if (usec < 4)
+      return (uint) usec;
+    uint e= my_bit_log2_uint64(usec);
+    return std::min((e - 1) * 4 + (uint) ((usec >> (e - 2)) & 3), BUCKETS - 1);
+  }
+  /* The largest value counted in bucket b. */
+  static ulonglong bucket_max(uint b)
+  {
+    if (b < 4)
+      return b;
+    return ((ulonglong) (5 + b % 4) << (b / 4 - 1)) - 1;
+  }
+  void add(ulonglong usec)
+  {
+    counts[bucket(usec)]++;
+    total++;
+  }
+  ulonglong percentile(uint pct) const
+  {
+    ulonglong target= (total * pct + 99) / 100, sum= 0;
+    for (uint b= 0; target && b < BUCKETS; b++)
+      if ((sum+= counts[b]) >= target)
+        return bucket_max(b);
+    return 0;
+  }
+};
+
 class MYSQL_BIN_LOG: public TC_LOG, public Event_log
 {
   friend Binlog_commit_by_rotate;
@@ -691,6 +731,11 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
       LOCK_commit_ordered has been released.
     */
     bool do_binlog_group_commit_ordered;
+    /*
+      microsecond_interval_timer() when the entry was put in the group commit
+      queue, or 0 if it did not go through the queue.
+    */
+    ulonglong queue_time;
   };
 
   /*
@@ -767,6 +812,16 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
   /* The reason why the group commit was grouped */
   ulonglong group_commit_trigger_count, group_commit_trigger_timeout;
   ulonglong group_commit_trigger_lock_wait;
+  /*
+    Moving averages, in microseconds, of the time to sync the binlog file and
+    of the interval between transactions queueing for group commit. They are
+    used to size the group commit delay with binlog_commit_wait_adaptive. The
+    arrival statistics are protected by LOCK_prepare_ordered.
+  */
+  std::atomic<ulonglong> sync_usec_avg;
+  ulonglong commit_interval_usec_avg, last_commit_queue_time;
+  /* Protected by LOCK_commit_ordered. */
+  Binlog_commit_latency_histogram commit_latency;
 
   /* Binlog GTID index. */
   Gtid_index_writer *gtid_index;
@@ -1036,6 +1091,25 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
     unlock_binlog_end_pos();
   }
 
+  /*
+    Like update_binlog_end_pos(pos), for a group commit that synced the
+    binlog after releasing LOCK_log. Another writer that synced the file
+    meanwhile may already have moved binlog_end_pos past pos.
+  */
+  void update_binlog_end_pos_after_sync(my_off_t pos)
+  {
+    DBUG_ASSERT(!opt_binlog_engine_hton);
+    mysql_mutex_assert_owner(&LOCK_after_binlog_sync);
+    lock_binlog_end_pos();
+    if (pos > binlog_end_pos)
+    {
+      binlog_end_pos= pos;
+      signal_bin_log_update();
+    }
+    unlock_binlog_end_pos();
+  }
+
+  void adapt_commit_wait(ulong *count, ulong *usec);
   void wait_for_sufficient_commits();
   void binlog_trigger_immediate_group_commit();
   void wait_for_update_relay_log(THD* thd);
@@ -1111,11 +1185,14 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
      be set to 1, otherwise 0.
 
      @param[out] synced if not NULL, set to 1 if file is synchronized, otherwise 0
+     @param[out] sync_due if not NULL, the file is not synchronized; instead
+                          this is set to 1 if the caller must synchronize it
 
      @retval 0 Success
      @retval other Failure
   */
-  bool flush_and_sync(bool *synced);
+  bool flush_and_sync(bool *synced, bool *sync_due= NULL);
+  void note_sync_time(ulonglong usec);
   int purge_logs(THD *thd, const char *to_log, bool included,
                  bool need_mutex, bool need_update_threads, bool interactive,
                  ulonglong *decrease_log_space);
@@ -1432,6 +1509,14 @@ enum enum_binlog_format {
   BINLOG_FORMAT_UNSPEC=3  ///< thd_binlog_format() returns it when binlog is closed
 };
 
+/** Values of binlog_transaction_dependency_tracking */
+enum enum_binlog_transaction_dependency_tracking {
+  /** Only the commit_id of the binlog group commit is recorded */
+  BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER= 0,
+  /** The dependency is computed from the hashes of the modified rows */
+  BINLOG_DEPENDENCY_TRACKING_WRITESET= 1
+};
+
 int query_error_code(THD *thd, bool not_killed);
 uint purge_log_get_error_code(int res);
 
@@ -1481,6 +1566,9 @@ int online_alter_log_row(TABLE* table, const uchar *before_record,
                          const uchar *after_record, Log_func *log_func);
 binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
                                          bool use_trans_cache);
+void binlog_writeset_add_row(binlog_cache_mngr *cache_mngr, TABLE *table,
+                             const uchar *before_record,
+                             const uchar *after_record);
 
 extern MYSQL_PLUGIN_IMPORT MYSQL_BIN_LOG mysql_bin_log;
 extern transaction_participant binlog_tp;
@@ -2591,7 +2591,7 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
                                const Format_description_log_event
                                *description_event)
   : Log_event(buf, description_event), seq_no(0), commit_id(0),
-    flags_extra(0), extra_engines(0), thread_id(0)
+    flags_extra(0), extra_engines(0), thread_id(0), dependency(0)
 {
   uint8 header_size= description_event->common_header_len;
   uint8 post_header_len= description_event->post_header_len[GTID_EVENT-1];
@@ -2676,6 +2676,17 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
       thread_id= uint4korr(buf);
       buf+= 4;
     }
+
+    if (flags_extra & FL_EXTRA_DEPENDENCY)
+    {
+      if (event_len < static_cast<uint>(buf - buf_0) + 8)
+      {
+        seq_no= 0;
+        return;
+      }
+      dependency= uint8korr(buf);
+      buf+= 8;
+    }
   }
   /*
     the strict '<' part of the assert corresponds to extra zero-padded
@@ -3229,7 +3240,8 @@ Rows_log_event::Rows_log_event(const uchar *buf, size_t event_len,
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    m_usable_key_parts(0), master_had_triggers(0)
+    m_usable_key_parts(0), master_had_triggers(0),
+    m_row_positions(NULL), m_n_row_positions(0), m_next_row_position(0)
 #endif
 {
   DBUG_ENTER("Rows_log_event::Rows_log_event(const char*,...)");
@@ -3366,14 +3366,16 @@ cap_gtid_event_size(uint32_t proposed_size)
 static constexpr uint32_t
 get_gtid_event_size(bool fl_commit_id, bool fl_xa, bool fl_extra,
                     bool fl_multi_engine, bool fl_alter,
-                    bool fl_thread_id, int bq_size, int gt_size)
+                    bool fl_thread_id, bool fl_dependency,
+                    int bq_size, int gt_size)
 {
   return cap_gtid_event_size((fl_commit_id ? GTID_HEADER_LEN + 2 : 13) +
                              (fl_xa ? 6 + bq_size + gt_size : 0) +
                              (fl_extra ? 1 : 0) +
                              (fl_multi_engine ? 1 : 0) +
                              (fl_alter ? 8 : 0) +
-                             (fl_thread_id ? 4 : 0));
+                             (fl_thread_id ? 4 : 0) +
+                             (fl_dependency ? 8 : 0));
 }
 #endif
 
@@ -3475,6 +3477,11 @@ class Gtid_log_event: public Log_event
   */
   uint8 extra_engines;
   my_thread_id thread_id;
+  /*
+    With FL_EXTRA_DEPENDENCY, the seq_no of the last prior event group in
+    this domain that modified any of the same rows, or 0 if there is none.
+  */
+  uint64 dependency;
 
   /* Flags2. */
 
@@ -3521,6 +3528,12 @@ class Gtid_log_event: public Log_event
   static constexpr uchar FL_COMMIT_ALTER_E1= 4;
   static constexpr uchar FL_ROLLBACK_ALTER_E1= 8;
   static constexpr uchar FL_EXTRA_THREAD_ID= 16; // thread_id like in BEGIN Query
+  /*
+    FL_EXTRA_DEPENDENCY is set when the master computed the dependency of the
+    event group from the rows it modified
+    (binlog_transaction_dependency_tracking=WRITESET).
+  */
+  static constexpr uchar FL_EXTRA_DEPENDENCY= 32;
 
 #ifdef MYSQL_SERVER
   static constexpr uint32_t max_size=
@@ -3528,7 +3541,8 @@ class Gtid_log_event: public Log_event
                         (bool)(FL_PREPARED_XA|FL_COMPLETED_XA),
                         true, FL_EXTRA_MULTI_ENGINE_E1,
                         (bool)(FL_COMMIT_ALTER_E1|FL_ROLLBACK_ALTER_E1),
-                        FL_EXTRA_THREAD_ID, MAXBQUALSIZE, MAXGTRIDSIZE);
+                        FL_EXTRA_THREAD_ID, FL_EXTRA_DEPENDENCY,
+                        MAXBQUALSIZE, MAXGTRIDSIZE);
 
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
                  enum_event_cache_type cache_type_arg, uint16 flags,
@@ -5026,6 +5040,17 @@ class Rows_log_event : public Log_event
   uint      m_usable_key_parts; /* A number of key_parts suited to lookup */
   bool master_had_triggers;     /* set after tables opening */
 
+  /* The location of a row of the event, found by find_row_positions() */
+  struct Row_position
+  {
+    const uchar *row;   /* Start of the before image in the event */
+    uint64 hash;        /* record_hash() of the before image */
+    uchar *pos;         /* handler::ref of the row, or NULL if not found */
+  };
+  Row_position *m_row_positions; /* Rows of the event in event order */
+  uint      m_n_row_positions;
+  uint      m_next_row_position; /* First element not consumed by find_row() */
+
   /*
     RAII helper class to automatically handle the override/restore of thd->db
     when applying row events, so it will be visible in SHOW PROCESSLIST.
@@ -5075,6 +5100,10 @@ class Rows_log_event : public Log_event
   uint find_key_parts(const KEY *key) const;
   bool use_pk_position() const;
   int find_row(rpl_group_info *);
+  void prefetch_rows(rpl_group_info *); // Queue the rows for prefetching
+  void find_row_positions(rpl_group_info *); // Locate rows in one scan
+  const uchar *take_row_position();
+  static int cmp_row_position_hash(void *rows, const void *a, const void *b);
   int update_sequence();
 
   // Unpack the current row into m_table->record[0], but with
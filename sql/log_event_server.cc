@@ -2931,7 +2931,7 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
     pad_to_size(0), flags2((standalone ? FL_STANDALONE : 0) |
            (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
     flags_extra(0), extra_engines(0),
-    thread_id(thd_arg->variables.pseudo_thread_id)
+    thread_id(thd_arg->variables.pseudo_thread_id), dependency(0)
 {
   cache_type= cache_type_arg;
   bool is_tmp_table= thd_arg->lex->stmt_accessed_temp_table();
@@ -3071,6 +3071,7 @@ Gtid_log_event::get_size() const noexcept
                              flags_extra & FL_EXTRA_MULTI_ENGINE_E1,
                              flags_extra & (FL_COMMIT_ALTER_E1 | FL_ROLLBACK_ALTER_E1),
                              flags_extra & FL_EXTRA_THREAD_ID,
+                             flags_extra & FL_EXTRA_DEPENDENCY,
                              (fl_xa ? xid.bqual_length : 0),
                              (fl_xa ? xid.gtrid_length : 0));
 }
@@ -3154,6 +3155,12 @@ Gtid_log_event::write(Log_event_writer *writer)
     write_len+= 4;
   }
 
+  if (flags_extra & FL_EXTRA_DEPENDENCY)
+  {
+    int8store(buf + write_len, dependency);
+    write_len+= 8;
+  }
+
   if (write_len < GTID_HEADER_LEN)
   {
     bzero(buf+write_len, GTID_HEADER_LEN-write_len);
@@ -4799,7 +4806,8 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0),
+    m_row_positions(NULL), m_n_row_positions(0), m_next_row_position(0)
 #endif
 {
   /*
@@ -5457,6 +5465,16 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     // Do event specific preparations 
     error= do_before_row_operations(rgi, &copy_info, &write_record);
 
+    if (!error && opt_slave_row_prefetch_threads &&
+        !rpl_data.is_online_alter() &&
+        (get_general_type_code() == DELETE_ROWS_EVENT ||
+         get_general_type_code() == UPDATE_ROWS_EVENT))
+      prefetch_rows(rgi);
+    if (!error && !m_key_info && !rpl_data.is_online_alter() &&
+        (get_general_type_code() == DELETE_ROWS_EVENT ||
+         get_general_type_code() == UPDATE_ROWS_EVENT))
+      find_row_positions(rgi);
+
     /*
       Bug#56662 Assertion failed: next_insert_id == 0, file handler.cc
       Don't allow generation of auto_increment value when processing
@@ -7877,6 +7895,26 @@ static bool record_compare(TABLE *table, bool vers_from_plain= false)
 record_compare_differ:
   return true;
 }
+
+
+/**
+  Hash the fields of table->record[0] that record_compare() compares.
+  Records that record_compare() considers equal have the same hash.
+*/
+static uint64 record_hash(TABLE *table)
+{
+  const bool all_values_set= bitmap_is_set_all(&table->has_value_set);
+  Hasher hasher(my_hasher_xxh3());
+
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    Field *f= *ptr;
+    if (f->vcol_info || (!all_values_set && !f->has_explicit_value()))
+      continue;
+    f->hash(&hasher);
+  }
+  return hasher.finalize();
+}
 /**
   Traverses default item expr of a field, and underlying field's default values.
   If it is an extra field and has no value replicated, then its default expr
@@ -8164,6 +8202,228 @@ static int end_of_file_error(rpl_group_info *rgi)
          ? HA_ERR_END_OF_FILE : HA_ERR_RECORD_CHANGED;
 }
 
+/**
+  Hand the keys of the rows of this event to @@slave_row_prefetch_threads.
+
+  find_row() locates the rows one at a time, so that on a cold buffer pool
+  the applier waits for one page read per row. The keys of all rows of the
+  event are extracted up front, and the prefetch threads look them up
+  concurrently while this thread applies the rows.
+
+  Only rows that can be located with a complete unique key are prefetched.
+*/
+void Rows_log_event::prefetch_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+
+  if (!m_key_info ||
+      (m_key_info->flags & (HA_NOSAME | HA_NULL_PART_KEY)) != HA_NOSAME ||
+      m_key_info->algorithm == HA_KEY_ALG_LONG_HASH ||
+      m_usable_key_parts != m_key_info->user_defined_key_parts ||
+      table->s->tmp_table != NO_TMP_TABLE || table->versioned())
+    return;
+  for (uint p= 0; p < m_usable_key_parts; p++)
+    if (m_key_info->key_part[p].field->vcol_info)
+      return;
+
+  const uint key_length= m_key_info->key_length;
+  StringBuffer<1024> keys(&my_charset_bin);
+  Dummy_error_handler error_handler;
+  Check_level_instant_set clis(thd, CHECK_FIELD_IGNORE);
+
+  /*
+    Unpack the rows into record[0]. find_row() will restore record[0]
+    before unpacking each row again.
+  */
+  thd->push_internal_handler(&error_handler);
+  for (const uchar *row= m_curr_row; row < m_rows_end; )
+  {
+    const uchar *row_end;
+    if (unpack_row(rgi, table, m_width, row, &m_cols, &row_end, m_rows_end) ||
+        keys.reserve(key_length, 64 * key_length))
+      break;
+    key_copy((uchar*) keys.ptr() + keys.length(), table->record[0],
+             m_key_info, 0);
+    keys.length(keys.length() + key_length);
+    if (is_update &&
+        unpack_row(rgi, table, m_width, row_end, &m_cols_ai, &row_end,
+                   m_rows_end))
+      break;
+    if (row_end <= row)
+      break;
+    row= row_end;
+  }
+  thd->pop_internal_handler();
+
+  if (uint n_keys= uint(keys.length() / key_length))
+    global_rpl_row_prefetch_pool.prefetch(table, m_key_nr,
+                                          (const uchar*) keys.ptr(), n_keys);
+}
+
+
+/** Order the indexes of Row_position elements by hash */
+int Rows_log_event::cmp_row_position_hash(void *rows, const void *a,
+                                          const void *b)
+{
+  const Row_position *r= static_cast<const Row_position*>(rows);
+  const uint64 ha= r[*static_cast<const uint*>(a)].hash;
+  const uint64 hb= r[*static_cast<const uint*>(b)].hash;
+  if (ha != hb)
+    return ha < hb ? -1 : 1;
+  /* Match equal rows in the order of the event. */
+  const uint ia= *static_cast<const uint*>(a), ib= *static_cast<const uint*>(b);
+  return ia < ib ? -1 : ia > ib;
+}
+
+
+/**
+  Locate all rows of an Update_rows or Delete_rows event in a single table
+  scan, when the table has no key that find_row() could use.
+
+  find_row() would scan the table once for every row of the event. Instead,
+  the before images are hashed, the table is scanned once, and the position
+  of each row that matches a before image is remembered. The rows are still
+  applied in the order of the event: find_row() fetches each row by its
+  position, and falls back to a table scan if the row was not found or no
+  longer matches, for example because it was created or changed by an
+  earlier row of the same event.
+*/
+void Rows_log_event::find_row_positions(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+
+  DBUG_ASSERT(!m_key_info);
+  DBUG_ASSERT(!m_row_positions);
+  if (table->versioned())
+    return;
+
+  Dynamic_array<Row_position> rows(PSI_INSTRUMENT_MEM);
+  Dummy_error_handler error_handler;
+  Check_level_instant_set clis(thd, CHECK_FIELD_IGNORE);
+
+  thd->push_internal_handler(&error_handler);
+  for (const uchar *row= m_curr_row; row < m_rows_end; )
+  {
+    const uchar *row_end;
+    restore_record(table, s->default_values);
+    if (unpack_row(rgi, table, m_width, row, &m_cols, &row_end, m_rows_end) ||
+        rows.append({row, record_hash(table), NULL}) ||
+        (is_update &&
+         unpack_row(rgi, table, m_width, row_end, &m_cols_ai, &row_end,
+                    m_rows_end)) ||
+        row_end <= row)
+    {
+      rows.clear();
+      break;
+    }
+    row= row_end;
+  }
+
+  const uint n= uint(rows.elements());
+  const uint ref_length= file->ref_length;
+  uint *order;
+  uchar *refs, *scan_row;
+  /* With a single row, find_row() would scan the table only once anyway. */
+  if (n < 2 ||
+      !my_multi_malloc(PSI_INSTRUMENT_ME, MYF(0),
+                       &m_row_positions, n * sizeof *m_row_positions,
+                       &order, n * sizeof *order,
+                       &refs, size_t{n} * ref_length,
+                       &scan_row, size_t{table->s->reclength},
+                       NullS))
+  {
+    thd->pop_internal_handler();
+    return;
+  }
+
+  memcpy(m_row_positions, rows.front(), n * sizeof *m_row_positions);
+  m_n_row_positions= n;
+  m_next_row_position= 0;
+  for (uint i= 0; i < n; i++)
+    order[i]= i;
+  my_qsort2(order, n, sizeof *order, cmp_row_position_hash, m_row_positions);
+
+  uint remaining= n;
+  if (!file->ha_rnd_init(1))
+  {
+    while (remaining && !thd->killed &&
+           !file->ha_rnd_next(table->record[0]))
+    {
+      const uint64 hash= record_hash(table);
+      /* Find the first before image with this hash. */
+      uint lo= 0, hi= n;
+      while (lo < hi)
+      {
+        const uint mid= (lo + hi) / 2;
+        if (m_row_positions[order[mid]].hash < hash)
+          lo= mid + 1;
+        else
+          hi= mid;
+      }
+
+      bool positioned= false;
+      for (; lo < n && m_row_positions[order[lo]].hash == hash; lo++)
+      {
+        Row_position &r= m_row_positions[order[lo]];
+        if (r.pos)
+          continue;
+        if (!positioned)
+        {
+          file->position(table->record[0]);
+          memcpy(scan_row, table->record[0], table->s->reclength);
+          positioned= true;
+        }
+        /* Compare the rows in the same way as find_row(). */
+        restore_record(table, s->default_values);
+        const uchar *row_end;
+        if (unpack_row(rgi, table, m_width, r.row, &m_cols, &row_end,
+                       m_rows_end))
+          continue;
+        normalize_null_bits(table);
+        store_record(table, record[1]);
+        memcpy(table->record[0], scan_row, table->s->reclength);
+        if (!record_compare(table))
+        {
+          r.pos= refs + size_t{order[lo]} * ref_length;
+          memcpy(r.pos, file->ref, ref_length);
+          remaining--;
+          break;
+        }
+      }
+    }
+    file->ha_rnd_end();
+  }
+  thd->pop_internal_handler();
+
+  DBUG_PRINT("info", ("located %u of %u rows in one table scan",
+                      n - remaining, n));
+}
+
+
+/**
+  @return the position of the current row that find_row_positions() found
+  @retval NULL if the position is not known
+*/
+const uchar *Rows_log_event::take_row_position()
+{
+  for (; m_next_row_position < m_n_row_positions; m_next_row_position++)
+  {
+    const Row_position &r= m_row_positions[m_next_row_position];
+    if (r.row == m_curr_row)
+    {
+      m_next_row_position++;
+      return r.pos;
+    }
+    if (r.row > m_curr_row)
+      break;
+  }
+  return NULL;
+}
+
+
 /**
   Locate the current row in event's table.
 
@@ -8416,6 +8676,18 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
 
+    if (const uchar *pos= take_row_position())
+    {
+      /* The row was located by find_row_positions(). */
+      if (table->file->inited == handler::NONE &&
+          unlikely((error= table->file->ha_rnd_init_with_error(0))))
+        goto end;
+      if (!table->file->ha_rnd_pos(table->record[0], const_cast<uchar*>(pos)) &&
+          !record_compare(table, m_vers_from_plain))
+        goto end;
+      table->file->ha_rnd_end();
+    }
+
     /* We don't have a key: search the table using rnd_next() */
     if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
     {
@@ -8522,6 +8794,9 @@ Delete_rows_log_event::do_after_row_operations(int error)
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  my_free(m_row_positions);
+  m_row_positions= NULL;
+  m_n_row_positions= 0;
 
   return error;
 }
@@ -8650,6 +8925,9 @@ Update_rows_log_event::do_after_row_operations(int error)
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  my_free(m_row_positions);
+  m_row_positions= NULL;
+  m_n_row_positions= 0;
 
   return error;
 }
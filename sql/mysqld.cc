@@ -50,6 +50,7 @@
 #include "derror.h"       // init_errmessage
 #include "sql_manager.h"  // stop_handle_manager, start_handle_manager
 #include "sql_expression_cache.h" // subquery_cache_miss, subquery_cache_hit
+#include "sql_parallel.h" // sql_parallel_end
 #include "sys_vars_shared.h"
 #include "ddl_log.h"
 #include "optimizer_defaults.h"
@@ -462,6 +463,7 @@ my_bool opt_binlog_gtid_index= TRUE;
 uint opt_binlog_gtid_index_page_size= 4096;
 uint opt_binlog_gtid_index_span_min= 65536;
 my_bool opt_master_verify_checksum= 0;
+ulong opt_binlog_dump_sendfile_min_size= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 const char *binlog_formats_create_tmp_names[]= {"MIXED", "STATEMENT", NullS};
@@ -527,6 +529,10 @@ uint max_password_errors;
 ulong extra_max_connections;
 uint max_digest_length= 0;
 ulong slave_retried_transactions;
+ulong slave_dependency_transactions, slave_dependency_waits;
+ulonglong slave_dependency_distance;
+ulonglong slave_prefetched_rows;
+ulonglong binlog_dump_sendfile_events;
 ulong transactions_multi_engine;
 ulong rpl_transactions_multi_engine;
 ulong transactions_gtid_foreign_engine;
@@ -576,7 +582,11 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+my_bool opt_binlog_commit_wait_adaptive= 0;
+ulong opt_binlog_transaction_dependency_tracking;
+ulong opt_binlog_transaction_dependency_history_size;
 ulong opt_slave_parallel_max_queued= 131072;
+ulong opt_slave_row_prefetch_threads= 0;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 uint opt_gtid_cleanup_batch_size= 64;
 
@@ -973,7 +983,8 @@ PSI_mutex_key key_RELAYLOG_LOCK_index;
 PSI_mutex_key key_LOCK_relaylog_end_pos;
 PSI_mutex_key key_LOCK_thread_id;
 PSI_mutex_key key_LOCK_slave_state, key_LOCK_binlog_state,
-  key_LOCK_rpl_thread, key_LOCK_rpl_thread_pool, key_LOCK_parallel_entry;
+  key_LOCK_rpl_thread, key_LOCK_rpl_thread_pool, key_LOCK_parallel_entry,
+  key_LOCK_rpl_row_prefetch;
 PSI_mutex_key key_LOCK_rpl_semi_sync_master_enabled;
 PSI_mutex_key key_LOCK_binlog;
 
@@ -1069,6 +1080,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread, "LOCK_rpl_thread", 0},
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
+  { &key_LOCK_rpl_row_prefetch, "LOCK_rpl_row_prefetch", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
   { &key_LOCK_rpl_semi_sync_master_enabled, "LOCK_rpl_semi_sync_master_enabled", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
@@ -1130,7 +1142,7 @@ PSI_cond_key key_TC_LOG_MMAP_COND_queue_busy;
 PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_rpl_thread_stop, key_COND_rpl_thread_pool,
   key_COND_parallel_entry, key_COND_group_commit_orderer,
-  key_COND_prepare_ordered;
+  key_COND_prepare_ordered, key_COND_rpl_row_prefetch;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
 
@@ -1177,6 +1189,7 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_parallel_entry, "COND_parallel_entry", 0},
   { &key_COND_group_commit_orderer, "COND_group_commit_orderer", 0},
   { &key_COND_prepare_ordered, "COND_prepare_ordered", 0},
+  { &key_COND_rpl_row_prefetch, "COND_rpl_row_prefetch", 0},
   { &key_COND_start_thread, "COND_start_thread", PSI_FLAG_GLOBAL},
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
@@ -1188,7 +1201,8 @@ static PSI_cond_info all_server_conds[]=
 PSI_thread_key key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
   key_thread_one_connection, key_thread_signal_hand,
-  key_thread_slave_background, key_rpl_parallel_thread;
+  key_thread_slave_background, key_rpl_parallel_thread,
+  key_rpl_row_prefetch_thread;
 PSI_thread_key key_thread_ack_receiver;
 
 static PSI_thread_info all_server_threads[]=
@@ -1200,7 +1214,8 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_bg", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
-  { &key_rpl_parallel_thread, "rpl_parallel", 0}
+  { &key_rpl_parallel_thread, "rpl_parallel", 0},
+  { &key_rpl_row_prefetch_thread, "rpl_row_prefetch", 0}
 };
 
 #ifdef HAVE_MMAP
@@ -1512,6 +1527,7 @@ int allow_severity = LOG_INFO;
 int deny_severity = LOG_WARNING;
 #endif
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
+uint query_cache_instances= 1;
 Query_cache query_cache;
 
 my_bool opt_use_ssl  = 1;
@@ -2031,6 +2047,7 @@ static void clean_up(bool print_message)
   sp_cache_end();
   free_status_vars();
   end_thr_timer();
+  sql_parallel_end();
 #ifndef EMBEDDED_LIBRARY
   Events::deinit();
 #endif
@@ -7636,6 +7653,48 @@ show_ssl_get_server_not_after(THD *thd, SHOW_VAR *var, void *buff,
 
 #endif /* HAVE_OPENSSL && !EMBEDDED_LIBRARY */
 
+static int show_query_cache(THD *thd, SHOW_VAR *var, void *buff,
+                            system_status_var *, enum_var_type)
+{
+  struct st_data {
+    Query_cache_statistics stats;
+    SHOW_VAR var[9];
+  } *data;
+  SHOW_VAR *v;
+
+  data=(st_data *)buff;
+  v= data->var;
+
+  var->type= SHOW_ARRAY;
+  var->value= v;
+
+  query_cache.get_statistics(&data->stats);
+
+#define set_one_query_cache_var(X,Y)    \
+  v->name= X;                           \
+  v->type= SHOW_LONGLONG;               \
+  v->value= &data->stats.Y;             \
+  v++;
+
+  set_one_query_cache_var("free_blocks",      free_blocks);
+  set_one_query_cache_var("free_memory",      free_memory);
+  set_one_query_cache_var("hits",             hits);
+  set_one_query_cache_var("inserts",          inserts);
+  set_one_query_cache_var("lowmem_prunes",    lowmem_prunes);
+  set_one_query_cache_var("not_cached",       not_cached);
+  set_one_query_cache_var("queries_in_cache", queries_in_cache);
+  set_one_query_cache_var("total_blocks",     total_blocks);
+
+  v->name= 0;
+
+  DBUG_ASSERT((char*)(v+1) <= static_cast<char*>(buff) + SHOW_VAR_FUNC_BUFF_SIZE);
+
+#undef set_one_query_cache_var
+
+  return 0;
+}
+
+
 static int show_default_keycache(THD *thd, SHOW_VAR *var, void *buff,
                                  system_status_var *, enum_var_type)
 {
@@ -7828,6 +7887,7 @@ SHOW_VAR status_vars[]= {
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
   {"Binlog_stmt_cache_use",    (char*) &binlog_stmt_cache_use,       SHOW_LONG},
   {"Binlog_disk_use",          (char*) &show_binlog_space_total, SHOW_SIMPLE_FUNC},
+  {"Binlog_dump_sendfile_events", (char*) &binlog_dump_sendfile_events, SHOW_LONGLONG},
   {"Busy_time",                (char*) offsetof(STATUS_VAR, busy_time), SHOW_MICROSECOND_STATUS},
   {"Bytes_received",           (char*) offsetof(STATUS_VAR, bytes_received), SHOW_LONGLONG_STATUS},
   {"Bytes_sent",               (char*) offsetof(STATUS_VAR, bytes_sent), SHOW_LONGLONG_STATUS},
@@ -7931,6 +7991,8 @@ SHOW_VAR status_vars[]= {
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONG_STATUS},
   {"Opened_views",             (char*) offsetof(STATUS_VAR, opened_views), SHOW_LONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_SIMPLE_FUNC},
+  {"Prepared_stmt_plan_cache_hits", (char*) offsetof(STATUS_VAR, plan_cache_hits), SHOW_LONG_STATUS},
+  {"Prepared_stmt_plan_cache_misses", (char*) offsetof(STATUS_VAR, plan_cache_misses), SHOW_LONG_STATUS},
   {"Rows_sent",                (char*) offsetof(STATUS_VAR, rows_sent), SHOW_LONGLONG_STATUS},
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
   {"Rows_tmp_read",            (char*) offsetof(STATUS_VAR, rows_tmp_read), SHOW_LONGLONG_STATUS},
@@ -7954,14 +8016,7 @@ SHOW_VAR status_vars[]= {
   SHOW_FUNC_ENTRY("Rpl_semi_sync_slave_status",  &rpl_semi_sync_enabled),
   {"Rpl_semi_sync_slave_send_ack", (char*) &rpl_semi_sync_slave_send_ack, SHOW_LONGLONG},
 #endif /* HAVE_REPLICATION */
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  SHOW_FUNC_ENTRY("Qcache",    &show_query_cache),
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Query_time",               (char*) offsetof(STATUS_VAR, query_time), SHOW_MICROSECOND_STATUS},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -7978,7 +8033,11 @@ SHOW_VAR status_vars[]= {
   {"Slaves_connected",        (char*) &binlog_dump_thread_count, SHOW_ATOMIC_COUNTER_UINT32_T},
   {"Slaves_running",          (char*) &show_slaves_running, SHOW_SIMPLE_FUNC },
   {"Slave_connections",       (char*) offsetof(STATUS_VAR, com_register_slave), SHOW_LONG_STATUS},
+  {"Slave_dependency_distance",(char*) &slave_dependency_distance, SHOW_LONGLONG},
+  {"Slave_dependency_transactions",(char*) &slave_dependency_transactions, SHOW_LONG},
+  {"Slave_dependency_waits",   (char*) &slave_dependency_waits, SHOW_LONG},
   {"Slave_heartbeat_period",   (char*) &show_heartbeat_period, SHOW_SIMPLE_FUNC},
+  {"Slave_prefetched_rows",    (char*) &slave_prefetched_rows, SHOW_LONGLONG},
   {"Slave_received_heartbeats",(char*) &show_slave_received_heartbeats, SHOW_SIMPLE_FUNC},
   {"Slave_retried_transactions",(char*)&slave_retried_transactions, SHOW_LONG},
   {"Slave_running",            (char*) &show_slave_running,     SHOW_SIMPLE_FUNC},
@@ -8314,6 +8373,11 @@ static int mysql_init_variables(void)
   report_user= report_password = report_host= 0;	/* TO BE DELETED */
   opt_relay_logname= opt_relaylog_index_name= 0;
   slave_retried_transactions= 0;
+  slave_dependency_transactions= 0;
+  slave_dependency_waits= 0;
+  slave_dependency_distance= 0;
+  slave_prefetched_rows= 0;
+  binlog_dump_sendfile_events= 0;
   transactions_multi_engine= 0;
   rpl_transactions_multi_engine= 0;
   transactions_gtid_foreign_engine= 0;
@@ -9645,6 +9709,7 @@ void refresh_global_status()
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters, 0); // MyISAM page caches
   aria_reset_pagecache_counters();                 // Aria page cache
+  query_cache.reset_statistics();
   global_status_var.flush_status_time= my_time(0);
   mysql_mutex_unlock(&LOCK_status);
 
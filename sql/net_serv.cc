@@ -453,6 +453,61 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
 }
 
 
+/**
+  Write a logical packet consisting of a header from memory followed by
+  len bytes of the file fd starting at offset. The header is written
+  through the net buffer, which is then flushed, and the file data is sent
+  with vio_sendfile() so that it is not copied through user space.
+
+  The packet must fit in a single packet, and compression must be off.
+
+  @retval 0 ok
+  @retval 1 error
+*/
+
+my_bool my_net_write_file(NET *net, const uchar *head, size_t head_len,
+                          int fd, unsigned long long offset, size_t len)
+{
+  uchar buff[NET_HEADER_SIZE];
+  DBUG_ENTER("my_net_write_file");
+  DBUG_ASSERT(!net->compress);
+  DBUG_ASSERT(head_len + len < MAX_PACKET_LENGTH);
+
+  if (unlikely(!net->vio)) /* nowhere to write */
+    DBUG_RETURN(0);
+
+  MYSQL_NET_WRITE_START(head_len + len);
+  int3store(buff, head_len + len);
+  buff[3]= (uchar) net->pkt_nr++;
+  if (net_write_buff(net, buff, NET_HEADER_SIZE) ||
+      net_write_buff(net, head, head_len) ||
+      net_flush(net))
+  {
+    MYSQL_NET_WRITE_DONE(1);
+    DBUG_RETURN(1);
+  }
+
+  net->reading_or_writing= 2;
+  if (vio_sendfile(net->vio, (File) fd, (my_off_t) offset, len) != len)
+  {
+    bool interrupted= vio_should_retry(net->vio) ||
+                      socket_errno == SOCKET_ETIMEDOUT;
+    net->error= 2;                              /* Close socket */
+    if (net->vio->state != VIO_STATE_SHUTDOWN || net->last_errno == 0)
+      net->last_errno= (interrupted ? ER_NET_WRITE_INTERRUPTED :
+                        ER_NET_ERROR_ON_WRITE);
+    MYSQL_SERVER_my_error(net->last_errno, MYF(0));
+    net->reading_or_writing= 0;
+    MYSQL_NET_WRITE_DONE(1);
+    DBUG_RETURN(1);
+  }
+  update_statistics(thd_increment_bytes_sent(net->thd, len));
+  net->reading_or_writing= 0;
+  MYSQL_NET_WRITE_DONE(0);
+  DBUG_RETURN(0);
+}
+
+
 /**
   Send a command to the server.
 
@@ -0,0 +1,203 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/**
+  @file
+  Join order cache for prepared statements, see opt_plan_cache.h.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "sql_select.h"
+#include "opt_plan_cache.h"
+#include <my_bit.h>
+
+
+/**
+  Check if the join order of the JOIN can be cached.
+
+  Only the SELECTs of prepared statements over base tables are handled.
+  Semi-join nests are left out: their strategies are chosen together with
+  the join order.
+*/
+
+static bool plan_cache_applicable(JOIN *join)
+{
+  THD *thd= join->thd;
+  if (!thd->variables.prepared_stmt_plan_cache ||
+      !thd->stmt_arena->is_stmt_execute() ||
+      join->table_count - join->const_tables < 2 ||
+      (join->select_options & SELECT_STRAIGHT_JOIN) ||
+      join->select_lex->sj_nests.elements)
+    return false;
+
+  for (uint i= 0; i < join->table_count; i++)
+  {
+    TABLE_LIST *tl= join->join_tab[i].tab_list;
+    if (!tl->is_non_derived() || tl->jtbm_subselect || tl->table_function ||
+        tl->schema_table ||
+        join->join_tab[i].table->s->tmp_table == INTERNAL_TMP_TABLE)
+      return false;
+  }
+  return true;
+}
+
+
+static inline uchar plan_cache_rows_class(const JOIN_TAB *tab)
+{
+  return (uchar) my_bit_log2_uint64((ulonglong) tab->found_records);
+}
+
+
+static bool plan_cache_key_matches(JOIN *join, const Plan_cache_entry *entry)
+{
+  if (entry->const_table_map != join->const_table_map)
+    return false;
+  for (uint i= 0; i < join->table_count; i++)
+  {
+    if (entry->rows_class[i] != plan_cache_rows_class(join->join_tab + i))
+      return false;
+  }
+  return true;
+}
+
+
+static bool plan_cache_tables_match(JOIN *join, const Plan_cache_entry *entry)
+{
+  for (uint i= 0; i < join->table_count; i++)
+  {
+    TABLE *table= join->join_tab[i].table;
+    if (entry->ref_version[i] != table->s->get_table_ref_version() ||
+        entry->stats[i] != table->stats_cb)
+      return false;
+  }
+  return true;
+}
+
+
+bool plan_cache_lookup(JOIN *join)
+{
+  THD *thd= join->thd;
+  join->cached_plan= NULL;
+  if (!plan_cache_applicable(join))
+    return false;
+
+  Plan_cache_entry **prev= &join->select_lex->plan_cache;
+  for (Plan_cache_entry *entry= *prev; entry; prev= &entry->next,
+       entry= entry->next)
+  {
+    if (!entry->valid)
+      continue;
+    if (entry->table_count != join->table_count ||
+        !plan_cache_tables_match(join, entry))
+    {
+      /* The tables have changed since the order was chosen */
+      entry->valid= false;
+      continue;
+    }
+    if (!plan_cache_key_matches(join, entry))
+      continue;
+
+    /* Keep the most recently used entries at the head of the list */
+    *prev= entry->next;
+    entry->next= join->select_lex->plan_cache;
+    join->select_lex->plan_cache= entry;
+    join->cached_plan= entry;
+    status_var_increment(thd->status_var.plan_cache_hits);
+    return true;
+  }
+  status_var_increment(thd->status_var.plan_cache_misses);
+  return true;
+}
+
+
+/**
+  Get an entry for a new join order. An invalid entry or, when the cache is
+  full, the least recently used one is reused, so that the memory of the
+  statement does not grow with the number of executions.
+*/
+
+static Plan_cache_entry *plan_cache_new_entry(JOIN *join)
+{
+  SELECT_LEX *select_lex= join->select_lex;
+  Plan_cache_entry **prev, **reuse= NULL, *entry;
+  uint n_entries= 0;
+
+  for (prev= &select_lex->plan_cache; (entry= *prev); prev= &entry->next)
+  {
+    n_entries++;
+    if (!entry->valid)
+    {
+      reuse= prev;
+      break;
+    }
+    if (!entry->next && n_entries >= PLAN_CACHE_MAX_ENTRIES)
+      reuse= prev;
+  }
+
+  if (reuse && (*reuse)->table_count == join->table_count)
+  {
+    entry= *reuse;
+    *reuse= entry->next;
+  }
+  else
+  {
+    MEM_ROOT *mem_root= join->thd->stmt_arena->mem_root;
+    uint n= join->table_count;
+    if (!(entry= new (mem_root) Plan_cache_entry) ||
+        !(entry->rows_class= (uchar*) alloc_root(mem_root, n)) ||
+        !(entry->ref_version=
+            (ulonglong*) alloc_root(mem_root, n * sizeof(ulonglong))) ||
+        !(entry->stats= (const TABLE_STATISTICS_CB**)
+            alloc_root(mem_root, n * sizeof(TABLE_STATISTICS_CB*))) ||
+        !(entry->order= (uint*) alloc_root(mem_root, n * sizeof(uint))))
+      return NULL;
+    entry->table_count= n;
+  }
+  entry->next= select_lex->plan_cache;
+  select_lex->plan_cache= entry;
+  return entry;
+}
+
+
+void plan_cache_store(JOIN *join)
+{
+  Plan_cache_entry *entry= plan_cache_new_entry(join);
+  if (!entry)
+    return;
+
+  entry->const_table_map= join->const_table_map;
+  for (uint i= 0; i < join->table_count; i++)
+  {
+    JOIN_TAB *tab= join->join_tab + i;
+    entry->rows_class[i]= plan_cache_rows_class(tab);
+    entry->ref_version[i]= tab->table->s->get_table_ref_version();
+    entry->stats[i]= tab->table->stats_cb;
+  }
+  for (uint i= join->const_tables; i < join->table_count; i++)
+    entry->order[i - join->const_tables]=
+      (uint) (join->best_positions[i].table - join->join_tab);
+  entry->valid= true;
+}
+
+
+void plan_cache_restore_order(JOIN *join)
+{
+  const Plan_cache_entry *entry= join->cached_plan;
+  DBUG_ASSERT(entry->table_count == join->table_count);
+  for (uint i= join->const_tables; i < join->table_count; i++)
+    join->best_ref[i]= join->join_tab + entry->order[i - join->const_tables];
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef OPT_PLAN_CACHE_INCLUDED
+#define OPT_PLAN_CACHE_INCLUDED
+
+/**
+  @file
+  Join order cache for prepared statements.
+
+  Every execution of a prepared statement optimizes its SELECTs again.
+  For joins of several tables most of that work is the search for the join
+  order in choose_plan(), and the order that is found usually does not
+  change between executions.
+
+  A SELECT_LEX of a prepared statement keeps the join orders chosen by its
+  earlier executions. An order is looked up by the selectivity class of the
+  current parameters: the set of constant tables and the order of magnitude
+  of the number of rows that range analysis expects from every table. On a
+  hit choose_plan() only computes the access methods and the cost of the
+  cached order, as it does for STRAIGHT_JOIN.
+
+  A cached order is dropped when the definition of a table changes (its
+  table_map_id) or when new engine independent statistics are loaded for it.
+
+  The cache belongs to the statement and is only used by the thread that
+  executes it, so it needs no locking.
+*/
+
+class JOIN;
+class TABLE_STATISTICS_CB;
+
+/* Join orders kept for one SELECT */
+#define PLAN_CACHE_MAX_ENTRIES 4
+
+class Plan_cache_entry: public Sql_alloc
+{
+public:
+  Plan_cache_entry *next;
+  bool valid;
+  /* Key: constant tables and the row count class of every table */
+  table_map const_table_map;
+  uchar *rows_class;
+  /* Identity of the tables the order has been chosen for */
+  ulonglong *ref_version;
+  const TABLE_STATISTICS_CB **stats;
+  uint table_count;
+  /* Indexes in JOIN::join_tab of the non-constant tables in join order */
+  uint *order;
+};
+
+/*
+  Look up the join order for the JOIN in the cache of its SELECT and set
+  JOIN::cached_plan on a hit. Returns FALSE if the cache is not used for
+  the JOIN.
+*/
+bool plan_cache_lookup(JOIN *join);
+
+/* Remember the join order in JOIN::best_positions */
+void plan_cache_store(JOIN *join);
+
+/* Put the non-constant tables in JOIN::best_ref in the cached order */
+void plan_cache_restore_order(JOIN *join);
+
+#endif /* OPT_PLAN_CACHE_INCLUDED */
@@ -66,25 +66,30 @@ static int maxmin_in_range(bool max_fl, Field* field, COND *cond);
 
   SYNOPSIS
     get_exact_records()
+    thd			Thread handler
     tables		List of tables
 
   NOTES
     When this is called, we know all table handlers supports HA_HAS_RECORDS
     or HA_STATS_RECORDS_IS_EXACT
 
+    EXPLAIN does not need the exact count, so records() is used instead
+    of records_for_count(), which may have to scan the table.
+
   RETURN
     ULONGLONG_MAX	Error: Could not calculate number of rows
     #			Multiplication of number of rows in all tables
 */
 
-static ulonglong get_exact_record_count(List<TABLE_LIST> &tables)
+static ulonglong get_exact_record_count(THD *thd, List<TABLE_LIST> &tables)
 {
   ulonglong count= 1;
   TABLE_LIST *tl;
   List_iterator<TABLE_LIST> ti(tables);
   while ((tl= ti++))
   {
-    ha_rows tmp= tl->table->file->records();
+    ha_rows tmp= thd->lex->describe ? tl->table->file->records() :
+                                      tl->table->file->records_for_count();
     if (tmp == HA_POS_ERROR)
       return ULONGLONG_MAX;
     count*= tmp;
@@ -365,7 +370,7 @@ int opt_sum_query(THD *thd,
         {
           if (!is_exact_count)
           {
-            if ((count= get_exact_record_count(tables)) == ULONGLONG_MAX)
+            if ((count= get_exact_record_count(thd, tables)) == ULONGLONG_MAX)
             {
               /* Error from handler in counting rows. Don't optimize count() */
               const_result= 0;
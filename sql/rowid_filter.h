@@ -374,6 +374,8 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
 
   uint elements() override { return refpos_container.elements(); }
 
+  uchar *get_pos(uint n) const { return refpos_container.get_pos(n); }
+
   void sort (int (*cmp) (void *ctxt, const void *el1, const void *el2),
                          void *cmp_arg) override
   {
@@ -3,6 +3,8 @@
 #include "slave.h"
 #include "rpl_mi.h"
 #include "sql_parse.h"
+#include "sql_base.h"
+#include "transaction.h"
 #include "debug_sync.h"
 #include "sql_repl.h"
 #include "wsrep_mysqld.h"
@@ -24,6 +26,7 @@
 
 
 struct rpl_parallel_thread_pool global_rpl_thread_pool;
+struct rpl_row_prefetch_pool global_rpl_row_prefetch_pool;
 
 static void signal_error_to_sql_driver_thread(THD *thd, rpl_group_info *rgi,
                                               int err);
@@ -552,6 +555,56 @@ do_ftwrl_wait(rpl_group_info *rgi,
 }
 
 
+/*
+  Do not start an event group until the prior event group that the master
+  recorded as its dependency (binlog_transaction_dependency_tracking=WRITESET)
+  has committed. Unlike SPECULATE_WAIT, this lets the event group run in
+  parallel with any other prior event groups.
+*/
+static void
+do_dependency_wait(rpl_group_info *rgi,
+                   bool *did_enter_cond, PSI_stage_info *old_stage)
+{
+  THD *thd= rgi->thd;
+  rpl_parallel_entry *entry= rgi->parallel_entry;
+  uint64 dependency_sub_id= rgi->dependency_sub_id;
+  DBUG_ENTER("do_dependency_wait");
+
+  mysql_mutex_assert_owner(&entry->LOCK_parallel_entry);
+
+  if (dependency_sub_id <= entry->last_committed_sub_id)
+    DBUG_VOID_RETURN;
+
+  statistic_increment(slave_dependency_waits, LOCK_status);
+  thd->set_time_for_next_stage();
+  thd->ENTER_COND(&entry->COND_parallel_entry, &entry->LOCK_parallel_entry,
+                  &stage_waiting_for_prior_transaction_to_commit,
+                  (*did_enter_cond ? nullptr : old_stage));
+  *did_enter_cond= true;
+  ++entry->need_sub_id_signal;
+  /*
+    Every prior event group eventually completes with finish_event_group(),
+    also in case of errors or STOP SLAVE, so this wait always terminates.
+  */
+  do
+  {
+    if (unlikely(thd->check_killed()))
+    {
+      slave_output_error_info(rgi, thd);
+      signal_error_to_sql_driver_thread(thd, rgi, 1);
+      break;
+    }
+    mysql_cond_wait(&entry->COND_parallel_entry, &entry->LOCK_parallel_entry);
+  } while (dependency_sub_id > entry->last_committed_sub_id);
+  --entry->need_sub_id_signal;
+  /*
+    We do not call EXIT_COND() here, as this will be done later by our
+    caller (since we set *did_enter_cond to true).
+  */
+  DBUG_VOID_RETURN;
+}
+
+
 static int
 pool_mark_busy(rpl_parallel_thread_pool *pool, THD *thd)
 {
@@ -1444,6 +1497,8 @@ handle_rpl_parallel_thread(void *arg)
         skip_event_group= do_stop_handling(rgi);
         if (likely(!skip_event_group))
           skip_event_group= do_ftwrl_wait(rgi, &did_enter_cond, &old_stage);
+        if (likely(!skip_event_group) && rgi->dependency_sub_id)
+          do_dependency_wait(rgi, &did_enter_cond, &old_stage);
 
         /*
           Register ourself to wait for the previous commit, if we need to do
@@ -2432,6 +2487,262 @@ rpl_parallel_thread_pool::copy_pool_for_pfs(Relay_log_info *rli)
   }
 }
 
+/*
+  Look up the rows of one rpl_row_prefetch_pool::task.
+
+  The table is opened with lock_wait_timeout=0 and read in READ UNCOMMITTED
+  mode, so that neither metadata locks nor row locks are waited for.
+*/
+static void
+rpl_row_prefetch_task(THD *thd, const rpl_row_prefetch_pool::task *t)
+{
+  TABLE_LIST tlist;
+
+  lex_start(thd);
+  thd->lex->sql_command= SQLCOM_SELECT;
+  tlist.init_one_table(&t->db, &t->table_name, NULL, TL_READ);
+  if (open_and_lock_tables(thd, &tlist, FALSE,
+                           MYSQL_OPEN_IGNORE_LOGGING_FORMAT))
+  {
+    thd->clear_error();
+    thd->release_transactional_locks();
+    return;
+  }
+
+  TABLE *table= tlist.table;
+  /* The table may have been altered after the task was queued. */
+  if (t->key_nr < table->s->keys &&
+      table->key_info[t->key_nr].key_length == t->key_length)
+  {
+    /* Fetch the whole row, so that the clustered index is accessed too. */
+    table->use_all_columns();
+    if (!table->file->ha_index_init(t->key_nr, FALSE))
+    {
+      const uchar *key= t->keys;
+      uint n;
+      for (n= 0; n < t->n_keys && !thd->killed; n++, key+= t->key_length)
+        table->file->ha_index_read_map(table->record[0], key, HA_WHOLE_KEY,
+                                       HA_READ_KEY_EXACT);
+      table->file->ha_index_end();
+      statistic_add(slave_prefetched_rows, n, &LOCK_status);
+    }
+  }
+
+  ha_commit_trans(thd, FALSE);
+  close_thread_tables(thd);
+  trans_commit(thd);
+  thd->release_transactional_locks();
+  thd->clear_error();
+}
+
+
+pthread_handler_t
+handle_rpl_row_prefetch(void *arg)
+{
+  rpl_row_prefetch_pool *pool= (rpl_row_prefetch_pool *)arg;
+
+  my_thread_init();
+  my_thread_set_name("rpl_prefetch");
+  THD *thd= new THD(next_thread_id());
+  server_threads.insert(thd);
+  set_current_thd(thd);
+  pthread_detach_this_thread();
+  thd->store_globals();
+  thd->init_for_queries();
+  init_thr_lock();
+  thd->system_thread= SYSTEM_THREAD_SLAVE_BACKGROUND;
+  thd->security_ctx->skip_grants();
+  thd->set_command(COM_DAEMON);
+  thd->variables.wsrep_on= 0;
+  thd->variables.tx_isolation= ISO_READ_UNCOMMITTED;
+  thd->variables.lock_wait_timeout= 0;
+  thd_proc_info(thd, "Waiting for rows to prefetch");
+
+  PSI_thread *psi= PSI_CALL_get_thread();
+  PSI_CALL_set_thread_os_id(psi);
+  PSI_CALL_set_thread_THD(psi, thd);
+  PSI_CALL_set_thread_id(psi, thd->thread_id);
+  thd->set_psi(psi);
+
+  mysql_mutex_lock(&pool->LOCK_rpl_row_prefetch);
+  /* Exit if the thread was killed, or if there are too many threads. */
+  while (!pool->stop && !thd->killed &&
+         pool->count <= opt_slave_row_prefetch_threads)
+  {
+    rpl_row_prefetch_pool::task *t= pool->queue;
+    if (!t)
+    {
+      mysql_cond_wait(&pool->COND_rpl_row_prefetch,
+                      &pool->LOCK_rpl_row_prefetch);
+      continue;
+    }
+    if (!(pool->queue= t->next))
+      pool->queue_last= &pool->queue;
+    pool->queued--;
+    mysql_mutex_unlock(&pool->LOCK_rpl_row_prefetch);
+
+    thd_proc_info(thd, "Prefetching rows");
+    rpl_row_prefetch_task(thd, t);
+    thd_proc_info(thd, "Waiting for rows to prefetch");
+    my_free(t);
+
+    mysql_mutex_lock(&pool->LOCK_rpl_row_prefetch);
+  }
+  pool->count--;
+  mysql_cond_broadcast(&pool->COND_rpl_row_prefetch);
+  mysql_mutex_unlock(&pool->LOCK_rpl_row_prefetch);
+
+  thd_proc_info(thd, "Slave row prefetch thread exiting");
+  THD_CHECK_SENTRY(thd);
+  server_threads.erase(thd);
+  delete thd;
+  my_thread_end();
+  return NULL;
+}
+
+
+int
+rpl_row_prefetch_pool::init()
+{
+  queue= NULL;
+  queue_last= &queue;
+  queued= 0;
+  count= 0;
+  stop= false;
+  mysql_mutex_init(key_LOCK_rpl_row_prefetch, &LOCK_rpl_row_prefetch,
+                   MY_MUTEX_INIT_SLOW);
+  mysql_cond_init(key_COND_rpl_row_prefetch, &COND_rpl_row_prefetch, NULL);
+  inited= true;
+  /* Threads are spawned on demand by prefetch(). */
+  return 0;
+}
+
+
+/* Stop all threads and discard any queued tasks. */
+void
+rpl_row_prefetch_pool::deactivate()
+{
+  if (!inited)
+    return;
+  mysql_mutex_lock(&LOCK_rpl_row_prefetch);
+  stop= true;
+  mysql_cond_broadcast(&COND_rpl_row_prefetch);
+  while (count)
+    mysql_cond_wait(&COND_rpl_row_prefetch, &LOCK_rpl_row_prefetch);
+  while (task *t= queue)
+  {
+    queue= t->next;
+    my_free(t);
+  }
+  queue_last= &queue;
+  queued= 0;
+  mysql_mutex_unlock(&LOCK_rpl_row_prefetch);
+}
+
+
+void
+rpl_row_prefetch_pool::destroy()
+{
+  if (!inited)
+    return;
+  deactivate();
+  mysql_mutex_destroy(&LOCK_rpl_row_prefetch);
+  mysql_cond_destroy(&COND_rpl_row_prefetch);
+  inited= false;
+}
+
+
+/*
+  Called when @@slave_row_prefetch_threads was changed. Any excess threads
+  will exit once they are idle; missing threads are spawned by prefetch().
+*/
+void
+rpl_row_prefetch_pool::resize()
+{
+  if (!inited)
+    return;
+  mysql_mutex_lock(&LOCK_rpl_row_prefetch);
+  mysql_cond_broadcast(&COND_rpl_row_prefetch);
+  mysql_mutex_unlock(&LOCK_rpl_row_prefetch);
+}
+
+
+/*
+  Queue keys of an index of a table for lookup.
+
+  The keys are split into contiguous slices, one for each thread, so that
+  rows that are adjacent in the event (and thus likely in the index) are
+  looked up by the same thread.
+
+  @param table   table of the row event
+  @param key_nr  index of table->key_info
+  @param keys    n_keys keys in the format of key_copy()
+  @param n_keys  number of keys
+*/
+void
+rpl_row_prefetch_pool::prefetch(const TABLE *table, uint key_nr,
+                                const uchar *keys, uint n_keys)
+{
+  const TABLE_SHARE *share= table->s;
+  const uint key_length= table->key_info[key_nr].key_length;
+  uint n_tasks= (uint) MY_MIN(opt_slave_row_prefetch_threads,
+                              n_keys / MIN_KEYS_PER_TASK);
+  if (!inited || !n_tasks)
+    return;
+
+  mysql_mutex_lock(&LOCK_rpl_row_prefetch);
+  const uint32 threads= (uint32) opt_slave_row_prefetch_threads;
+  while (!stop && count < threads)
+  {
+    pthread_t th;
+    if (mysql_thread_create(key_rpl_row_prefetch_thread, &th,
+                            &connection_attrib, handle_rpl_row_prefetch,
+                            this))
+      break;
+    count++;
+  }
+  if (stop || !count || queued >= threads * MAX_QUEUED_PER_THREAD)
+    n_tasks= 0;
+  else
+    set_if_smaller(n_tasks, threads * MAX_QUEUED_PER_THREAD - queued);
+
+  for (uint i= 0; i < n_tasks; i++)
+  {
+    /* Distribute the keys as evenly as possible. */
+    const uint first= (uint) (ulonglong{n_keys} * i / n_tasks);
+    const uint n= (uint) (ulonglong{n_keys} * (i + 1) / n_tasks) - first;
+    task *t;
+    char *db, *table_name;
+    uchar *buf;
+    if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(0),
+                         &t, sizeof *t,
+                         &db, share->db.length + 1,
+                         &table_name, share->table_name.length + 1,
+                         &buf, size_t{n} * key_length,
+                         NullS))
+      break;
+    t->next= NULL;
+    t->db.str= db;
+    t->db.length= share->db.length;
+    strmake(db, share->db.str, share->db.length);
+    t->table_name.str= table_name;
+    t->table_name.length= share->table_name.length;
+    strmake(table_name, share->table_name.str, share->table_name.length);
+    t->key_nr= key_nr;
+    t->key_length= key_length;
+    t->n_keys= n;
+    memcpy(buf, keys + size_t{first} * key_length, size_t{n} * key_length);
+    t->keys= buf;
+    *queue_last= t;
+    queue_last= &t->next;
+    queued++;
+  }
+  if (n_tasks)
+    mysql_cond_broadcast(&COND_rpl_row_prefetch);
+  mysql_mutex_unlock(&LOCK_rpl_row_prefetch);
+}
+
+
 /* 
   START ALTER , COMMIT ALTER / ROLLBACK ALTER scheduling
   
@@ -2596,6 +2907,24 @@ rpl_parallel_entry::check_scheduling_generation(sched_bucket *cur)
 }
 
 
+/*
+  Look up the event group that the master recorded as the dependency of a
+  new event group (binlog_transaction_dependency_tracking=WRITESET).
+
+  Returns the sub_id of the dependency, or 0 if it is not among the recently
+  queued event groups.
+*/
+uint64
+rpl_parallel_entry::find_dependency(const Gtid_log_event *gtid_ev) const
+{
+  const recent_group &g= recent_groups[gtid_ev->dependency % RECENT_GROUPS];
+  if (!gtid_ev->dependency || g.seq_no != gtid_ev->dependency ||
+      g.domain_id != gtid_ev->domain_id)
+    return 0;
+  return g.sub_id;
+}
+
+
 rpl_parallel_entry::sched_bucket *
 rpl_parallel_entry::check_xa_xid_dependency(xid_t *xid)
 {
@@ -3448,6 +3777,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     group_commit_orderer *gco;
     uint8 force_switch_flag;
     enum rpl_group_info::enum_speculation speculation;
+    uint64 dependency_sub_id= 0;
 
     if (!(rgi= cur_thread->get_rgi(rli, gtid_ev, e, event_size)))
     {
@@ -3518,9 +3848,17 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
           before starting.
         */
         new_gco= false;
+        /*
+          With binlog_transaction_dependency_tracking=WRITESET, the master
+          recorded the last prior event group that modified the same rows.
+          Then FL_WAITED does not matter, as we know what to wait for.
+        */
+        const bool has_dependency= gtid_ev->flags_extra &
+          Gtid_log_event::FL_EXTRA_DEPENDENCY;
         if (!(gtid_flags & Gtid_log_event::FL_TRANSACTIONAL) ||
             ( (!(gtid_flags & Gtid_log_event::FL_ALLOW_PARALLEL) ||
-               (gtid_flags & Gtid_log_event::FL_WAITED)) &&
+               ((gtid_flags & Gtid_log_event::FL_WAITED) &&
+                !has_dependency)) &&
               (mode < SLAVE_PARALLEL_AGGRESSIVE)))
         {
           /*
@@ -3537,7 +3875,30 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
           speculation= rpl_group_info::SPECULATE_WAIT;
         }
         else
+        {
           speculation= rpl_group_info::SPECULATE_OPTIMISTIC;
+          if (has_dependency)
+          {
+            /*
+              Wait for the dependency to commit before starting. If it is
+              the immediately preceding event group, wait_for_prior_commit()
+              already does that. If it is not among the recently queued
+              event groups, it has most likely committed already, and any
+              conflict will still be handled by rollback and retry.
+            */
+            dependency_sub_id= e->find_dependency(gtid_ev);
+            if (dependency_sub_id && dependency_sub_id == e->current_sub_id)
+            {
+              speculation= rpl_group_info::SPECULATE_WAIT;
+              dependency_sub_id= 0;
+            }
+            statistic_increment(slave_dependency_transactions, LOCK_status);
+            statistic_add(slave_dependency_distance,
+                          MY_MIN(gtid_ev->seq_no - gtid_ev->dependency,
+                                 rpl_parallel_entry::RECENT_GROUPS),
+                          LOCK_status);
+          }
+        }
       }
       gco->flags= flags;
     }
@@ -3547,6 +3908,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         force_switch_flag= group_commit_orderer::FORCE_SWITCH;
     }
     rgi->speculation= speculation;
+    rgi->dependency_sub_id= dependency_sub_id;
 
     if (gtid_flags & Gtid_log_event::FL_GROUP_COMMIT_ID)
       e->last_commit_id= gtid_ev->commit_id;
@@ -3582,6 +3944,12 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     qev->rgi= e->current_group_info= rgi;
     e->current_sub_id= rgi->gtid_sub_id;
     ++e->count_queued_event_groups;
+
+    rpl_parallel_entry::recent_group &recent= e->recent_groups
+      [gtid_ev->seq_no % rpl_parallel_entry::RECENT_GROUPS];
+    recent.seq_no= gtid_ev->seq_no;
+    recent.sub_id= rgi->gtid_sub_id;
+    recent.domain_id= gtid_ev->domain_id;
   }
   else if (!is_group_event)
   {
@@ -343,6 +343,58 @@ struct rpl_parallel_thread_pool {
 };
 
 
+/*
+  Threads that look up the rows of row events ahead of the worker that
+  applies them (--slave-row-prefetch-threads).
+
+  An event group is applied and committed by a single THD, so the rows of a
+  large transaction cannot be applied by several workers. Instead, the
+  applier of an Update_rows or Delete_rows event hands the keys of the rows
+  to these threads, which read the rows with their own THD, without row
+  locks and without waiting for metadata locks. The index pages are then
+  likely to be in the buffer pool when the applier locates the rows.
+
+  The applier never waits for a prefetch. A task that cannot be performed,
+  for example because the table was altered or because too many tasks are
+  queued already, is simply discarded.
+*/
+struct rpl_row_prefetch_pool {
+  /* Keys of rows to look up in one index of a table */
+  struct task {
+    task *next;
+    LEX_CSTRING db;
+    LEX_CSTRING table_name;
+    uint key_nr;
+    uint key_length;
+    uint n_keys;
+    const uchar *keys;
+  };
+  /* Limit on the number of tasks in the queue, per thread */
+  static constexpr uint32 MAX_QUEUED_PER_THREAD= 4;
+  /* Do not create tasks of fewer keys than this */
+  static constexpr uint MIN_KEYS_PER_TASK= 8;
+
+  mysql_mutex_t LOCK_rpl_row_prefetch;
+  /* Signalled when a task is queued, and when a thread exits */
+  mysql_cond_t COND_rpl_row_prefetch;
+  /* Tasks in FIFO order */
+  task *queue, **queue_last;
+  uint32 queued;
+  /* Number of running threads */
+  uint32 count;
+  /* Set by deactivate() to make all threads exit */
+  bool stop;
+  bool inited;
+
+  int init();
+  void deactivate();
+  void destroy();
+  void resize();
+  void prefetch(const TABLE *table, uint key_nr, const uchar *keys,
+                uint n_keys);
+};
+
+
 struct rpl_parallel_entry {
   /*
     A small struct to put worker threads references into a FIFO (using an
@@ -480,6 +532,20 @@ struct rpl_parallel_entry {
   /* Relay log info of replication source for this entry. */
   Relay_log_info *rli;
 
+  /*
+    The sub_id of recently queued event groups, indexed by GTID seq_no modulo
+    RECENT_GROUPS, used to map the dependency recorded by the master in the
+    GTID event to the event group to wait for. Only accessed by the SQL
+    driver thread.
+  */
+  struct recent_group {
+    uint64 seq_no;
+    uint64 sub_id;
+    uint32 domain_id;
+  };
+  static constexpr uint RECENT_GROUPS= 1024;
+  recent_group recent_groups[RECENT_GROUPS];
+
   void check_scheduling_generation(sched_bucket *cur);
   sched_bucket *check_xa_xid_dependency(xid_t *xid);
   rpl_parallel_thread * choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
@@ -490,6 +556,7 @@ struct rpl_parallel_entry {
                          rpl_group_info *rgi, PSI_stage_info *old_stage);
   int queue_master_restart(rpl_group_info *rgi,
                            Format_description_log_event *fdev);
+  uint64 find_dependency(const Gtid_log_event *gtid_ev) const;
   /*
     the initial size of maybe_ array corresponds to the case of
     each worker receives perhaps unlikely XA-PREPARE and XA-COMMIT within
@@ -514,6 +581,7 @@ struct rpl_parallel {
 
 
 extern struct rpl_parallel_thread_pool global_rpl_thread_pool;
+extern struct rpl_row_prefetch_pool global_rpl_row_prefetch_pool;
 
 
 extern void wait_for_pending_deadlock_kill(THD *thd, rpl_group_info *rgi);
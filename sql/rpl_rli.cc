@@ -2095,6 +2095,7 @@ rpl_group_info::reinit(Relay_log_info *rli)
   orig_exec_time= 0;
   gtid_ignore_duplicate_state= GTID_DUPLICATE_NULL;
   speculation= SPECULATE_NO;
+  dependency_sub_id= 0;
   rpt= NULL;
   start_alter_ev= NULL;
   direct_commit_alter= false;
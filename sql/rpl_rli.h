@@ -937,6 +937,13 @@ struct rpl_group_info
     */
     SPECULATE_WAIT
   } speculation;
+  /*
+    With SPECULATE_OPTIMISTIC, the sub_id of a prior event group that the
+    master recorded as modifying some of the same rows
+    (binlog_transaction_dependency_tracking=WRITESET), or 0. The event group
+    does not start before that event group has committed.
+  */
+  uint64 dependency_sub_id;
   enum enum_retry_killed {
     RETRY_KILL_NONE = 0,
     RETRY_KILL_PENDING,
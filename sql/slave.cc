@@ -552,7 +552,8 @@ int init_slave()
   init_slave_psi_keys();
 #endif
 
-  if (global_rpl_thread_pool.init(opt_slave_parallel_threads))
+  if (global_rpl_thread_pool.init(opt_slave_parallel_threads) ||
+      global_rpl_row_prefetch_pool.init())
     return 1;
 
   slave_background_thread_gtid_loaded= false;
@@ -1276,6 +1277,7 @@ void slave_prepare_for_shutdown()
   // It's safe to destruct worker pool now when
   // all driver threads are gone.
   global_rpl_thread_pool.deactivate();
+  global_rpl_row_prefetch_pool.deactivate();
 }
 
 /*
@@ -1307,6 +1309,7 @@ void end_slave()
   mysql_mutex_unlock(&LOCK_active_mi);
 
   global_rpl_thread_pool.destroy();
+  global_rpl_row_prefetch_pool.destroy();
   free_all_rpl_filters();
   DBUG_VOID_RETURN;
 }
@@ -76,6 +76,9 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
       writer->add_size(sort_buffer_size);
   }
 
+  if (r_sort_threads > 1)
+    writer->add_member("r_sort_threads").add_ll(r_sort_threads);
+
   get_data_format(&str);
   writer->add_member("r_sort_mode").add_str(str.ptr(), str.length());
 }
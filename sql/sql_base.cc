@@ -10148,7 +10148,8 @@ int TABLE::hlindexes_on_delete_all(bool truncate)
   return 0;
 }
 
-int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
+int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                              Rowid_filter *filter)
 {
   DBUG_ASSERT(s->hlindexes() == 1);
   DBUG_ASSERT(nr == s->keys);
@@ -10158,7 +10159,7 @@ int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
 
   DBUG_ASSERT(hlindex->in_use == in_use);
 
-  return mhnsw_read_first(this, key_info + s->keys, item, limit);
+  return mhnsw_read_first(this, key_info + s->keys, item, limit, filter);
 }
 
 int TABLE::hlindex_read_next()
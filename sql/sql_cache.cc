@@ -1074,6 +1074,14 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (has_instances())
+  {
+    /* The result is stored by the instance that registered the query */
+    query_cache_tls->instance->insert(thd, query_cache_tls, packet, length,
+                                      pkt_nr);
+    DBUG_VOID_RETURN;
+  }
+
   QC_DEBUG_SYNC("wait_in_query_cache_insert");
 
   /*
@@ -1112,8 +1120,8 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query %p", query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1137,6 +1145,12 @@ Query_cache::abort(THD *thd, Query_cache_tls *query_cache_tls)
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (has_instances())
+  {
+    query_cache_tls->instance->abort(thd, query_cache_tls);
+    DBUG_VOID_RETURN;
+  }
+
   if (try_lock(thd, Query_cache::WAIT))
     DBUG_VOID_RETURN;
 
@@ -1173,6 +1187,12 @@ void Query_cache::end_of_result(THD *thd)
   if (query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (has_instances())
+  {
+    query_cache_tls->instance->end_of_result(thd);
+    DBUG_VOID_RETURN;
+  }
+
   /* Ensure that only complete results are cached. */
   DBUG_ASSERT(thd->get_stmt_da()->is_eof());
 
@@ -1226,9 +1246,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     align_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, align_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, align_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->set_results_ready(); // signal for plugin
@@ -1278,6 +1298,7 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
    queries_in_cache(0), hits(0), inserts(0), refused(0),
    total_blocks(0), lowmem_prunes(0),
    m_cache_status(OK),
+   instances(NULL), n_instances(1), table_filter(NULL),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
    def_query_hash_size(ALIGN_SIZE(def_query_hash_size_arg)),
@@ -1301,6 +1322,23 @@ size_t Query_cache::resize(size_t query_cache_size_arg)
 			query_cache_size_arg));
   DBUG_ASSERT(initialized);
 
+  if (has_instances())
+  {
+    /* Every instance gets an equal share of the memory */
+    new_query_cache_size= 0;
+    for (uint i= 0; i < n_instances; i++)
+      new_query_cache_size+=
+        instances[i].resize(query_cache_size_arg / n_instances);
+
+    lock_and_suspend();
+    query_cache_size= new_query_cache_size;
+    m_cache_status= (new_query_cache_size &&
+                     global_system_variables.query_cache_type != 0) ?
+                    OK : DISABLED;
+    unlock();
+    DBUG_RETURN(new_query_cache_size);
+  }
+
   lock_and_suspend();
 
   /*
@@ -1354,12 +1392,69 @@ size_t Query_cache::resize(size_t query_cache_size_arg)
 size_t Query_cache::set_min_res_unit(size_t size)
 {
   DBUG_ASSERT(size % 8 == 0);
+  for (uint i= 0; i < n_instances && instances; i++)
+    instances[i].set_min_res_unit(size);
   if (size < min_allocation_unit)
     size= ALIGN_SIZE(min_allocation_unit);
   return (min_result_data_size= size);
 }
 
 
+void Query_cache::result_size_limit(size_t limit)
+{
+  query_cache_limit= limit;
+  for (uint i= 0; i < n_instances && instances; i++)
+    instances[i].result_size_limit(limit);
+}
+
+
+/**
+  Choose the instance that caches a query. The choice depends on the query
+  text only, so that send_result_to_client() and store_query() agree on it.
+*/
+
+Query_cache *Query_cache::instance_for(const char *query,
+                                       size_t query_length)
+{
+  DBUG_ASSERT(has_instances());
+  return instances + my_crc32c(0, query, query_length) % n_instances;
+}
+
+
+/**
+  Slot of the table filter for a table key. The key is hashed with the
+  collation of the tables hash (see init_cache()) so that the keys that
+  find the same table also use the same slot.
+*/
+
+uint Query_cache::table_filter_slot(const uchar *key, size_t key_length)
+{
+#ifndef FN_NO_CASE_SENSE
+  CHARSET_INFO *cs= &my_charset_bin;
+#else
+  CHARSET_INFO *cs= lower_case_table_names ? &my_charset_bin :
+                                             files_charset_info;
+#endif
+  return my_hash_sort(cs, key, key_length) &
+         (QUERY_CACHE_TABLE_FILTER_SIZE - 1);
+}
+
+
+/**
+  Count a table that is added to or removed from the tables hash.
+
+  The counters are changed with the cache locked, and are read without
+  the lock by invalidate_table() of the cache that owns the instance.
+*/
+
+void Query_cache::table_filter_add(const uchar *key, size_t key_length,
+                                   int count)
+{
+  if (table_filter)
+    table_filter[table_filter_slot(key, key_length)].fetch_add(count);
+}
+
+
 void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 {
   TABLE_COUNTER_TYPE local_tables;
@@ -1368,6 +1463,14 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
   size_t query_length;
   uint8 tables_type;
   DBUG_ENTER("Query_cache::store_query");
+
+  if (has_instances())
+  {
+    instance_for(thd->query(), thd->query_length())->
+      store_query(thd, tables_used);
+    DBUG_VOID_RETURN;
+  }
+
   /*
     Testing 'query_cache_size' without a lock here is safe: the thing
     we may loose is that the query won't be cached, but we save on
@@ -1567,6 +1670,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 	inserts++;
 	queries_in_cache++;
 	thd->query_cache_tls.first_query_block= query_block;
+	thd->query_cache_tls.instance= this;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
 
@@ -1721,6 +1825,10 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
   const char *sql, *sql_end, *found_brace= 0;
   DBUG_ENTER("Query_cache::send_result_to_client");
 
+  if (has_instances())
+    DBUG_RETURN(instance_for(org_sql, query_length)->
+                send_result_to_client(thd, org_sql, query_length));
+
   /*
     Testing without a lock here is safe: the thing
     we may loose is that the query won't be served from cache, but we
@@ -2358,6 +2466,13 @@ void Query_cache::invalidate(THD *thd, const LEX_CSTRING &db)
 
   DBUG_SLOW_ASSERT(Lex_ident_fs(db).ok_for_lower_case_names());
 
+  if (has_instances())
+  {
+    for (uint i= 0; i < n_instances; i++)
+      instances[i].invalidate(thd, db);
+    DBUG_VOID_RETURN;
+  }
+
   bool restart= FALSE;
   /*
     Lock the query cache and queue all invalidation attempts to avoid
@@ -2447,6 +2562,13 @@ void Query_cache::flush()
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (has_instances())
+  {
+    for (uint i= 0; i < n_instances; i++)
+      instances[i].flush();
+    DBUG_VOID_RETURN;
+  }
+
   QC_DEBUG_SYNC("wait_in_query_cache_flush1");
 
   lock_and_suspend();
@@ -2457,7 +2579,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2480,6 +2602,13 @@ void Query_cache::pack(THD *thd, size_t join_limit, uint iteration_limit)
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (has_instances())
+  {
+    for (uint i= 0; i < n_instances; i++)
+      instances[i].pack(thd, join_limit, iteration_limit);
+    DBUG_VOID_RETURN;
+  }
+
   /*
     If the entire qc is being invalidated we can bail out early
     instead of waiting for the lock.
@@ -2523,25 +2652,89 @@ void Query_cache::destroy()
     initialized = 0;
     DBUG_ASSERT(m_requests_in_progress == 0);
   }
+  if (instances)
+  {
+    for (uint i= 0; i < n_instances; i++)
+    {
+      instances[i].destroy();
+      my_free(instances[i].table_filter);
+      instances[i].~Query_cache();
+    }
+    my_free(instances);
+    instances= NULL;
+    n_instances= 1;
+  }
   DBUG_VOID_RETURN;
 }
 
 
 void Query_cache::disable_query_cache(THD *thd)
 {
+  for (uint i= 0; i < n_instances && instances; i++)
+    instances[i].disable_query_cache(thd);
   lock(thd);
   m_cache_status= DISABLE_REQUEST;
   unlock();
 }
 
 
+void Query_cache::get_statistics(Query_cache_statistics *stats)
+{
+  bzero(stats, sizeof(*stats));
+  Query_cache *first= has_instances() ? instances : this;
+  for (Query_cache *qc= first; qc < first + n_instances; qc++)
+  {
+    stats->free_blocks+= qc->free_memory_blocks;
+    stats->free_memory+= qc->free_memory;
+    stats->hits+= qc->hits;
+    stats->inserts+= qc->inserts;
+    stats->lowmem_prunes+= qc->lowmem_prunes;
+    stats->not_cached+= qc->refused;
+    stats->queries_in_cache+= qc->queries_in_cache;
+    stats->total_blocks+= qc->total_blocks;
+  }
+}
+
+
+void Query_cache::reset_statistics()
+{
+  hits= inserts= lowmem_prunes= refused= 0;
+  for (uint i= 0; i < n_instances && instances; i++)
+    instances[i].reset_statistics();
+}
+
+
 /*****************************************************************************
   init/destroy
 *****************************************************************************/
 
-void Query_cache::init()
+void Query_cache::init(uint n_instances_arg)
 {
   DBUG_ENTER("Query_cache::init");
+  if (n_instances_arg > 1)
+  {
+    /*
+      The instances are zero filled like the global query_cache object,
+      free_cache() relies on it before the first resize().
+    */
+    instances= (Query_cache*) my_malloc(key_memory_Query_cache,
+                                        n_instances_arg * sizeof(Query_cache),
+                                        MYF(MY_WME | MY_ZEROFILL));
+    if (instances)
+    {
+      n_instances= n_instances_arg;
+      for (uint i= 0; i < n_instances; i++)
+      {
+        Query_cache *qc= new (instances + i) Query_cache(query_cache_limit);
+        qc->set_min_res_unit(min_result_data_size);
+        qc->table_filter= (std::atomic<uint32>*)
+          my_malloc(key_memory_Query_cache,
+                    QUERY_CACHE_TABLE_FILTER_SIZE * sizeof(std::atomic<uint32>),
+                    MYF(MY_WME | MY_ZEROFILL));
+        qc->init();
+      }
+    }
+  }
   mysql_mutex_init(key_structure_guard_mutex,
                    &structure_guard_mutex, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_COND_cache_status_changed,
@@ -2784,6 +2977,11 @@ void Query_cache::make_disabled()
   first_block= 0;
   total_blocks= 0;
   tables_blocks= 0;
+  if (table_filter)
+  {
+    for (uint i= 0; i < QUERY_CACHE_TABLE_FILTER_SIZE; i++)
+      table_filter[i].store(0, std::memory_order_relaxed);
+  }
   DBUG_VOID_RETURN;
 }
 
@@ -3302,6 +3500,17 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
+  if (has_instances())
+  {
+    /* Only the instances that may cache the table are locked */
+    for (uint i= 0; i < n_instances; i++)
+    {
+      if (instances[i].may_have_table(key, key_length))
+        instances[i].invalidate_table(thd, key, key_length);
+    }
+    return;
+  }
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -3587,6 +3796,8 @@ Query_cache::insert_table(THD *thd, size_t key_len, const char *key,
     header->callback(callback);
     header->engine_data(engine_data);
     header->set_hashed(hash);
+    if (hash)
+      table_filter_add((uchar*) key, key_len, 1);
 
     /*
       We insert this table without the assumption that it isn't referenced by
@@ -3642,7 +3853,10 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
                                &tables_blocks);
     Query_cache_table *header= table_block->table();
     if (header->is_hashed())
+    {
+      table_filter_add(header->data(), header->key_length(), -1);
       my_hash_delete(&tables,(uchar *) table_block);
+    }
     free_memory_block(table_block);
   }
   DBUG_VOID_RETURN;
@@ -4872,6 +5086,13 @@ my_bool Query_cache::check_integrity(bool locked)
   uint i;
   DBUG_ENTER("check_integrity");
 
+  if (has_instances())
+  {
+    for (i= 0; i < n_instances; i++)
+      result|= instances[i].check_integrity(locked);
+    DBUG_RETURN(result);
+  }
+
   if (!locked)
     lock_and_suspend();
 
@@ -18,6 +18,7 @@
 
 #include "hash.h"
 #include "my_base.h"                            /* ha_rows */
+#include <atomic>
 
 class MY_LOCALE;
 struct TABLE_LIST;
@@ -66,6 +67,15 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
 
+/* maximal number of query cache instances (query_cache_instances) */
+#define QUERY_CACHE_MAX_INSTANCES		64
+
+/*
+  number of slots of the filter of cached tables of an instance
+  (see Query_cache::may_have_table()), must be a power of 2
+*/
+#define QUERY_CACHE_TABLE_FILTER_SIZE		1024
+
 #define TABLE_COUNTER_TYPE uint
 
 struct Query_cache_block;
@@ -297,6 +307,13 @@ struct Query_cache_memory_bin_step
   }
 };
 
+/* Statistics of the query cache, the Qcache_% status variables */
+struct Query_cache_statistics
+{
+  ulonglong free_blocks, free_memory, hits, inserts, lowmem_prunes,
+    not_cached, queries_in_cache, total_blocks;
+};
+
 class Query_cache
 {
 public:
@@ -321,6 +338,37 @@ class Query_cache
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(uchar *key, size_t key_length);
 
+  /*
+    With query_cache_instances > 1 the global query_cache object holds no
+    queries itself. It routes every request to one of the instances, each
+    of which is a complete cache with its own lock, memory and tables:
+    queries are assigned to an instance by the hash of their text, and
+    invalidations are sent to every instance that may have cached queries
+    on the table.
+  */
+  Query_cache *instances;
+  uint n_instances;
+  /*
+    Number of cached tables per slot, indexed by the hash of the table key.
+    Only maintained by the instances of a cache with several instances.
+  */
+  std::atomic<uint32> *table_filter;
+
+  bool has_instances() const { return n_instances > 1; }
+  Query_cache *instance_for(const char *query, size_t query_length);
+  static uint table_filter_slot(const uchar *key, size_t key_length);
+  void table_filter_add(const uchar *key, size_t key_length, int count);
+  /*
+    Check without locking if the instance can have queries that use the
+    table. A FALSE result is reliable as the tables of a query are
+    registered before the query is executed.
+  */
+  bool may_have_table(const uchar *key, size_t key_length) const
+  {
+    return !table_filter ||
+           table_filter[table_filter_slot(key, key_length)].load() != 0;
+  }
+
 protected:
   /*
     The following mutex is locked when searching or changing global
@@ -457,12 +505,12 @@ class Query_cache
   inline bool is_disable_in_progress(void)
   { return m_cache_status == DISABLE_REQUEST; }
 
-  /* initialize cache (mutex) */
-  void init();
+  /* initialize cache (mutex) and its instances */
+  void init(uint n_instances_arg= 1);
   /* resize query cache (return real query size, 0 if disabled) */
   size_t resize(size_t query_cache_size);
   /* set limit on result size */
-  inline void result_size_limit(size_t limit){query_cache_limit=limit;}
+  void result_size_limit(size_t limit);
   /* set minimal result data allocation unit size */
   size_t set_min_res_unit(size_t size);
 
@@ -541,6 +589,10 @@ class Query_cache
   void unlock(void);
 
   void disable_query_cache(THD *thd);
+
+  /* Sum the statistics of all instances, for SHOW STATUS */
+  void get_statistics(Query_cache_statistics *stats);
+  void reset_statistics();
 };
 
 struct Query_cache_query_flags
@@ -574,7 +626,7 @@ struct Query_cache_query_flags
 #define query_cache_store_query(A, B) query_cache.store_query(A, B)
 #define query_cache_destroy() query_cache.destroy()
 #define query_cache_result_size_limit(A) query_cache.result_size_limit(A)
-#define query_cache_init() query_cache.init()
+#define query_cache_init() query_cache.init(query_cache_instances)
 #define query_cache_resize(A) query_cache.resize(A)
 #define query_cache_set_min_res_unit(A) query_cache.set_min_res_unit(A)
 #define query_cache_invalidate3(A, B, C) query_cache.invalidate(A, B, C)
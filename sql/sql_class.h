@@ -608,6 +608,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -616,12 +617,14 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* The instance of the query cache that stores the query */
+  Query_cache *instance;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), instance(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -891,6 +894,7 @@ typedef struct system_variables
   uint32     gtid_domain_id;
 
   uint group_concat_max_len;
+  uint max_sort_threads;
   uint eq_range_index_dive_limit;
   uint idle_transaction_timeout;
   uint idle_readonly_transaction_timeout;
@@ -928,6 +932,8 @@ typedef struct system_variables
 #endif // USER_VAR_TRACKING
   my_bool tcp_nodelay;
   my_bool optimizer_record_context;
+  my_bool join_cache_spill;
+  my_bool prepared_stmt_plan_cache;
   plugin_ref table_plugin;
   plugin_ref tmp_table_plugin;
   plugin_ref enforced_table_plugin;
@@ -1052,6 +1058,8 @@ typedef struct system_status_var
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
   ulong optimizer_join_prefixes_check_calls;
+  ulong plan_cache_hits;
+  ulong plan_cache_misses;
 
   /* Features used */
   ulong feature_custom_aggregate_functions; /* +1 when custom aggregate
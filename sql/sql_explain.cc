@@ -2332,6 +2332,9 @@ void Explain_table_access::print_explain_json(Explain_query *query,
       else
         writer->add_null();
 
+      if (jbuf_spill_tracker.has_scans())
+        writer->add_member("r_spill_partitions").
+          add_ll(jbuf_spill_tracker.get_loops());
     }
   }
 
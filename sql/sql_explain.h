@@ -925,6 +925,9 @@ class Explain_table_access : public Sql_alloc
   /* When using join buffer: Track the number of incoming record combinations */
   Counter_tracker jbuf_loops_tracker;
 
+  /* When using join buffer: Track the partitions joined from temporary files */
+  Counter_tracker jbuf_spill_tracker;
+
   Explain_rowid_filter *rowid_filter;
 
   int print_explain(select_result_sink *output, uint8 explain_flags, 
@@ -31,6 +31,11 @@
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
+/* Limits for the partitioned mode of the BNLH join (see start_spill()) */
+#define JOIN_CACHE_MAX_SPILL_PARTITIONS  64
+#define JOIN_CACHE_SPILL_FILL_FACTOR     1.25
+#define JOIN_CACHE_SPILL_FILE_BUFF_SIZE  (IO_SIZE*4)
+
 static void save_or_restore_used_tabs(JOIN_TAB *join_tab, bool save);
 
 /*****************************************************************************
@@ -2846,7 +2851,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= &JOIN_CACHE_HASHED::get_hash_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2855,7 +2860,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   {
     if (!key_part->field->eq_cmp_as_binary())
     {
-      hash_func= &JOIN_CACHE_HASHED::get_hash_idx_complex;
+      hash_func= &JOIN_CACHE_HASHED::get_hash_complex;
       hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_complex;
       break;
     }
@@ -3247,7 +3252,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
                                    uchar **key_ref_ptr) 
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
+  uint idx= (uint) ((this->*hash_func)(key, key_length) % hash_entries);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
   while (!is_null_key_ref(ref_ptr))
   {
@@ -3271,21 +3276,22 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
   Hash function that considers a key in the hash table as byte array
 
   SYNOPSIS
-    get_hash_idx_simple()
+    get_hash_simple()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It considers the key just as
-    a sequence of bytes of the length key_len.
+    The function calculates the hash value for the given key. It considers
+    the key just as a sequence of bytes of the length key_len.
+    The index of the hash entry in the hash table of the join buffer is
+    the hash value modulo the number of hash entries.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3296,7 +3302,7 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
 }
 
 
@@ -3304,14 +3310,14 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
   Hash function that takes into account collations of the components of the key  
 
   SYNOPSIS
-    get_hash_idx_complex()
+    get_hash_complex()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It takes into account that the
-    components of the key may be of a varchar type with different collations.
+    The function calculates the hash value for the given key. It takes into
+    account that the components of the key may be of a varchar type with
+    different collations.
     The function guarantees that the same hash value for any two equal
     keys that may differ as byte sequences.
     The function takes the info about the components of the key, their
@@ -3320,14 +3326,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     operation.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_complex(uchar *key, uint key_len)
 {
-  return 
-    (uint) (key_hashnr(ref_key_info, ref_used_key_parts, key) % hash_entries);
+  return (ulong) key_hashnr(ref_key_info, ref_used_key_parts, key);
 }
 
 
@@ -3626,6 +3631,72 @@ void JOIN_TAB_SCAN::close()
 }
 
 
+/* 
+  Initiate an iteration over the records of join_tab saved in a partition file
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    The function positions the partition file set by set_file() at its
+    beginning. The file may be read several times if the records of the
+    previous tables from the corresponding partition do not fit into the
+    join buffer.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_SPILL::open()
+{
+  save_or_restore_used_tabs(join_tab, FALSE);
+  return reinit_io_cache(file, READ_CACHE, 0L, 0, 0);
+}
+
+
+/* 
+  Read the next record of join_tab from a partition file
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    The function reads the next record saved in the partition file into
+    the record buffer of join_tab. The records were checked against the
+    condition pushed to join_tab when they were written into the file.
+
+  RETURN VALUE   
+    0            the next record has been successfully read 
+    -1           there are no more records in the file
+    1            an error occurred when reading the file
+*/
+
+int JOIN_TAB_SCAN_SPILL::next()
+{
+  TABLE *table= join_tab->table;
+  if (my_b_read(file, table->record[0], table->s->reclength))
+    return file->error ? 1 : -1;
+  return 0;
+}
+
+
+/* 
+  Perform finalizing actions for an iteration over a partition file
+
+  SYNOPSIS
+    close()
+
+  RETURN VALUE   
+    none      
+*/
+
+void JOIN_TAB_SCAN_SPILL::close()
+{
+  save_or_restore_used_tabs(join_tab, TRUE);
+}
+
+
 /*
   Prepare to iterate over the BNL join cache buffer to look for matches 
 
@@ -3962,7 +4033,413 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  if (JOIN_CACHE_HASHED::init(for_explain))
+    DBUG_RETURN(1);
+
+  /*
+    The partitioned mode is not supported for linked caches, outer joins,
+    semi-joins with the first match strategy and when rowids or dynamic
+    range scans are used for join_tab. Whether a linked cache follows
+    this one and whether blobs are read is checked when the buffer
+    becomes full.
+  */
+  can_spill= !for_explain && join->thd->variables.join_cache_spill &&
+             !prev_cache && !with_match_flag &&
+             !join_tab->first_inner && !join_tab->bush_root_tab &&
+             !join_tab->check_only_first_match() &&
+             !join_tab->keep_current_rowid && join_tab->use_quick != 2;
+  if (can_spill && !(spill_scan= new JOIN_TAB_SCAN_SPILL(join, join_tab)))
+    DBUG_RETURN(1);
+
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Check whether any blob column of a table is read by the query
+*/
+
+static bool table_reads_blobs(TABLE *table)
+{
+  for (uint i= 0; i < table->s->blob_fields; i++)
+  {
+    if (bitmap_is_set(table->read_set, table->s->blob_field[i]))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Get the partition for a join key in the partitioned mode of BNLH
+
+  SYNOPSIS
+    get_spill_partition()
+      key   the join key value
+
+  DESCRIPTION
+    The function uses the hash function of the hash table so that equal
+    keys that differ as byte sequences end up in the same partition. The
+    hash value is scrambled first: otherwise the records of one partition
+    would occupy only a fraction of the entries of the hash table.
+
+  RETURN VALUE
+    the number of the partition for the key
+*/
+
+uint JOIN_CACHE_BNLH::get_spill_partition(uchar *key)
+{
+  ulonglong nr= (ulonglong) (this->*hash_func)(key, key_length);
+  return (uint) (((nr * 0x9E3779B97F4A7C15ULL) >> 32) % spill_partitions);
+}
+
+
+/*
+  Switch the BNLH join to the partitioned mode
+
+  SYNOPSIS
+    start_spill()
+
+  DESCRIPTION
+    The function is called when the join buffer has become full. It creates
+    temporary files for the partitions of the records of the previous tables
+    (build side) and of the records of join_tab (probe side) and moves all
+    records from the join buffer into the build side files. The number of
+    partitions is chosen so that the records of one partition are expected
+    to fit into the join buffer.
+
+  RETURN VALUE
+    FALSE  the join has been switched to the partitioned mode
+    TRUE   an error occurred
+*/
+
+bool JOIN_CACHE_BNLH::start_spill()
+{
+  size_t n_records= (size_t) records;
+  double prefix_rows= (join_tab-1)->get_partial_join_cardinality();
+  double n_parts;
+  DBUG_ENTER("JOIN_CACHE_BNLH::start_spill");
+
+  set_if_bigger(prefix_rows, 2.0 * n_records);
+  n_parts= ceil(prefix_rows * JOIN_CACHE_SPILL_FILL_FACTOR / n_records);
+  set_if_smaller(n_parts, JOIN_CACHE_MAX_SPILL_PARTITIONS);
+  spill_partitions= (uint) n_parts;
+
+  if (!(build_files= (IO_CACHE*) my_malloc(key_memory_JOIN_CACHE,
+                                           2 * spill_partitions *
+                                           sizeof(IO_CACHE),
+                                           MYF(MY_THREAD_SPECIFIC | MY_WME |
+                                               MY_ZEROFILL))))
+    DBUG_RETURN(TRUE);
+  probe_files= build_files + spill_partitions;
+
+  for (uint i= 0; i < 2 * spill_partitions; i++)
+  {
+    if (open_cached_file(build_files + i, mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_CACHE_SPILL_FILE_BUFF_SIZE,
+                         MYF(MY_WME | MY_TRACK_WITH_LIMIT)))
+      DBUG_RETURN(TRUE);
+  }
+
+  /* Move the records from the join buffer into the partition files */
+  reset(FALSE);
+  for (size_t i= 0; i < n_records; i++)
+  {
+    get_record();
+    if (spill_prefix_record())
+      DBUG_RETURN(TRUE);
+  }
+  reset(TRUE);
+  DBUG_RETURN(FALSE);
+}
+
+
+/*
+  Write the current partial join record into a build side partition file
+
+  SYNOPSIS
+    spill_prefix_record()
+
+  DESCRIPTION
+    The function saves the record buffers of all tables whose fields are
+    stored in the join buffer. The record buffers rather than the packed
+    record from the join buffer are saved because then the record can be
+    put into the join buffer again by the regular put_record() call.
+
+  RETURN VALUE
+    FALSE  the record has been written
+    TRUE   an error occurred
+*/
+
+bool JOIN_CACHE_BNLH::spill_prefix_record()
+{
+  TABLE_REF *ref= &join_tab->ref;
+  IO_CACHE *file;
+
+  cp_buffer_from_ref(join->thd, join_tab->table, ref);
+  file= build_files + get_spill_partition(ref->key_buff);
+
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uchar null_row= (uchar) table->null_row;
+    if (my_b_write(file, &null_row, 1) ||
+        my_b_write(file, table->record[0], table->s->reclength) ||
+        (tab->keep_current_rowid &&
+         my_b_write(file, table->file->ref, table->file->ref_length)))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Restore a partial join record from a build side partition file
+
+  SYNOPSIS
+    read_spilled_prefix_record()
+      file   the partition file to read from
+
+  DESCRIPTION
+    The function reads the record saved by spill_prefix_record() back
+    into the record buffers of the tables.
+
+  RETURN VALUE
+    0      the record has been read
+    -1     there are no more records in the file
+    1      an error occurred
+*/
+
+int JOIN_CACHE_BNLH::read_spilled_prefix_record(IO_CACHE *file)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uchar null_row;
+    if (my_b_read(file, &null_row, 1))
+      return tab == start_tab && !file->error ? -1 : 1;
+    if (my_b_read(file, table->record[0], table->s->reclength) ||
+        (tab->keep_current_rowid &&
+         my_b_read(file, table->file->ref, table->file->ref_length)))
+      return 1;
+    table->null_row= null_row;
+  }
+  return 0;
+}
+
+
+/*
+  Distribute the records of join_tab over the probe side partition files
+
+  SYNOPSIS
+    spill_join_tab_records()
+
+  DESCRIPTION
+    The function scans join_tab once. Each record that satisfies the
+    condition pushed to join_tab is written into the partition file
+    determined by its join key.
+
+  RETURN VALUE
+    NESTED_LOOP_OK      the records have been distributed
+    NESTED_LOOP_KILLED  the query has been killed
+    NESTED_LOOP_ERROR   an error occurred
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::spill_join_tab_records()
+{
+  TABLE *table= join_tab->table;
+  KEY *keyinfo= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  int error;
+  DBUG_ENTER("JOIN_CACHE_BNLH::spill_join_tab_records");
+
+  table->null_row= 0;
+  if (join_tab_execution_startup(join_tab) < 0)
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  if (join_tab->need_to_build_rowid_filter &&
+      join_tab->build_range_rowid_filter())
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+
+  if (!(error= join_tab_scan->open()))
+  {
+    while (!(error= join_tab_scan->next()))
+    {
+      if (unlikely(join->thd->check_killed()))
+      {
+        rc= NESTED_LOOP_KILLED;
+        break;
+      }
+      key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+      if (my_b_write(probe_files + get_spill_partition(key_buff),
+                     table->record[0], table->s->reclength))
+      {
+        rc= NESTED_LOOP_ERROR;
+        break;
+      }
+    }
+  }
+  if (error > 0)
+    rc= NESTED_LOOP_ERROR;
+  join_tab_scan->close();
+  DBUG_RETURN(rc);
+}
+
+
+/*
+  Close the partition files of the partitioned mode of BNLH
+*/
+
+void JOIN_CACHE_BNLH::end_spill()
+{
+  if (build_files)
+  {
+    for (uint i= 0; i < 2 * spill_partitions; i++)
+      close_cached_file(build_files + i);
+    my_free(build_files);
+  }
+  build_files= probe_files= 0;
+  spill_partitions= 0;
+  spill_error= FALSE;
+}
+
+
+/*
+  Put the next record into the buffer of a BNLH join cache
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    The function adds the current partial join record into the join buffer.
+    If the buffer becomes full and the join may be performed in the
+    partitioned mode the function moves the records from the buffer into
+    partition files instead of reporting that the buffer is full. After
+    this all further records are written directly into the partition files.
+    The records of join_tab are then scanned only once by
+    join_matching_records() rather than once per refill of the buffer.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  if (spill_partitions)
+  {
+    if (!spill_error && spill_prefix_record())
+      spill_error= TRUE;
+    return spill_error;
+  }
+
+  if (!JOIN_CACHE_HASHED::put_record())
+    return FALSE;
+
+  if (!can_spill || next_cache || blobs || table_reads_blobs(join_tab->table))
+    return TRUE;
+
+  if (start_spill())
+    spill_error= TRUE;
+  return spill_error;
+}
+
+
+/*
+  Find matches from join_tab for the records of a BNLH join cache
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last    do not look for matches for the last partial join record 
+
+  DESCRIPTION
+    If the join has not been switched to the partitioned mode the function
+    just calls the implementation of the base class.
+    Otherwise the function first distributes the records of join_tab over
+    the probe side partition files. Then for each partition it loads the
+    records of the previous tables from the build side file into the join
+    buffer and looks for the matches among the records of join_tab from
+    the probe side file. If the records of a partition do not fit into the
+    join buffer the probe side file is read once per buffer refill.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_matching_records(bool skip_last)
+{
+  enum_nested_loop_state rc;
+  JOIN_TAB_SCAN *save_join_tab_scan;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_matching_records");
+
+  if (!spill_partitions && !spill_error)
+    DBUG_RETURN(JOIN_CACHE::join_matching_records(skip_last));
+
+  DBUG_ASSERT(!skip_last);
+  if (spill_error)
+  {
+    end_spill();
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+  if ((rc= spill_join_tab_records()) != NESTED_LOOP_OK)
+  {
+    end_spill();
+    DBUG_RETURN(rc);
+  }
+
+  save_join_tab_scan= join_tab_scan;
+  join_tab_scan= spill_scan;
+  for (uint part= 0; part < spill_partitions; part++)
+  {
+    IO_CACHE *build_file= build_files + part;
+    int error;
+
+    join_tab->jbuf_spill_tracker->on_scan_init();
+    spill_scan->set_file(probe_files + part);
+    if (reinit_io_cache(build_file, READ_CACHE, 0L, 0, 0))
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    reset(TRUE);
+    while (!(error= read_spilled_prefix_record(build_file)))
+    {
+      if (JOIN_CACHE_HASHED::put_record())
+      {
+        rc= JOIN_CACHE::join_matching_records(FALSE);
+        reset(TRUE);
+        if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+          goto finish;
+      }
+    }
+    if (error > 0)
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    rc= JOIN_CACHE::join_matching_records(FALSE);
+    if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+      break;
+  }
+
+finish:
+  join_tab_scan= save_join_tab_scan;
+  reset(TRUE);
+  end_spill();
+  DBUG_RETURN(rc);
+}
+
+
+/*
+  Free the join buffer and the partition files of a BNLH join cache
+*/
+
+void JOIN_CACHE_BNLH::free()
+{
+  end_spill();
+  JOIN_CACHE_HASHED::free();
 }
 
 
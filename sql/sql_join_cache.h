@@ -680,7 +680,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() = default;
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -775,7 +775,7 @@ class JOIN_CACHE :public Sql_alloc
 class JOIN_CACHE_HASHED: public JOIN_CACHE
 {
 
-  typedef uint (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
+  typedef ulong (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
   typedef bool (JOIN_CACHE_HASHED::*Hash_cmp_func) (uchar *key1, uchar *key2,
                                                     uint key_len);
   
@@ -803,8 +803,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
-  inline uint get_hash_idx_simple(uchar *key, uint key_len);
-  inline uint get_hash_idx_complex(uchar *key, uint key_len);
+  inline ulong get_hash_simple(uchar *key, uint key_len);
+  inline ulong get_hash_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
   inline bool equal_keys_complex(uchar *key1, uchar *key2, uint key_len);
@@ -1098,6 +1098,34 @@ class JOIN_TAB_SCAN: public Sql_alloc
 
 };
 
+/*
+  The class JOIN_TAB_SCAN_SPILL is a companion class for the class
+  JOIN_CACHE_BNLH used when the join has been switched to the partitioned
+  mode. It iterates over the records of join_tab saved in the temporary file
+  of one partition instead of scanning the table itself. The records in the
+  file have already been checked against the condition pushed to join_tab.
+*/
+
+class JOIN_TAB_SCAN_SPILL: public JOIN_TAB_SCAN
+{
+  /* The file with the records of the partition to iterate over */
+  IO_CACHE *file;
+
+public:
+
+  JOIN_TAB_SCAN_SPILL(JOIN *j, JOIN_TAB *tab)
+    :JOIN_TAB_SCAN(j, tab), file(0) {}
+
+  void set_file(IO_CACHE *f) { file= f; }
+
+  int open() override;
+
+  int next() override;
+
+  void close() override;
+};
+
+
 /*
   The class JOIN_CACHE_BNL is used when the BNL join algorithm is
   employed to perform a join operation   
@@ -1159,6 +1187,31 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 {
 
+private:
+
+  /*
+    TRUE if the join can be switched to the partitioned (Grace hash join)
+    mode when the join buffer becomes full
+  */
+  bool can_spill;
+  /* Set if writing or reading a partition file has failed */
+  bool spill_error;
+  /* Number of partitions, 0 if the join is not in the partitioned mode */
+  uint spill_partitions;
+  /* Partition files for the records of the previous tables */
+  IO_CACHE *build_files;
+  /* Partition files for the records of join_tab */
+  IO_CACHE *probe_files;
+  /* The scan object used to iterate over the records of one partition */
+  JOIN_TAB_SCAN_SPILL *spill_scan;
+
+  uint get_spill_partition(uchar *key);
+  bool start_spill();
+  bool spill_prefix_record();
+  int read_spilled_prefix_record(IO_CACHE *file);
+  enum_nested_loop_state spill_join_tab_records();
+  void end_spill();
+
 protected:
 
   /* 
@@ -1190,6 +1243,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr) override;
 
+  /* Find matches for the records from the buffer or from partition files */
+  enum_nested_loop_state join_matching_records(bool skip_last) override;
+
 public:
 
   /* 
@@ -1197,7 +1253,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), can_spill(FALSE), spill_error(FALSE),
+      spill_partitions(0), build_files(0), probe_files(0), spill_scan(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,11 +1264,17 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), can_spill(FALSE), spill_error(FALSE),
+      spill_partitions(0), build_files(0), probe_files(0), spill_scan(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain) override;
 
+  /* Add a record into the join buffer or into a partition file */
+  bool put_record() override;
+
+  void free() override;
+
   enum Join_algorithm get_join_alg() override { return BNLH_JOIN_ALG; }
 
   bool is_key_access() override { return TRUE; }
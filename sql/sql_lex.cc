@@ -3177,6 +3177,7 @@ void st_select_lex::init_query()
   orig_names_of_item_list_elems= 0;
   opt_hints_qb= 0;
   parsed_optimizer_hints= 0;
+  plan_cache= 0;
 }
 
 void st_select_lex::init_select()
@@ -3232,6 +3233,7 @@ void st_select_lex::init_select()
   item_list_usage= MARK_COLUMNS_READ;
   opt_hints_qb= 0;
   parsed_optimizer_hints= 0;
+  plan_cache= 0;
 }
 
 /*
@@ -184,6 +184,7 @@ class select_handler;
 class Pushdown_select;
 class Opt_hints_global;
 class Opt_hints_qb;
+class Plan_cache_entry;
 class Optimizer_hint_parser_output;
 
 #define ALLOC_ROOT_SET 1024
@@ -1312,6 +1313,9 @@ class st_select_lex: public st_select_lex_node
   /* Optimizer hints that prescribe how to execute this SELECT */
   Opt_hints_qb *opt_hints_qb;
 
+  /* Join orders chosen by earlier executions of a prepared statement */
+  Plan_cache_entry *plan_cache;
+
   /* Set to 1 if any field in field list has ROWNUM() */
   bool rownum_in_field_list;
 
@@ -0,0 +1,128 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include "mariadb.h"
+#include "sql_parallel.h"
+#include <tpool.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+static std::atomic<tpool::thread_pool*> sql_pool;
+static std::mutex sql_pool_mutex;
+
+static void sql_pool_thread_init()
+{
+  my_thread_init();
+}
+
+static void sql_pool_thread_end()
+{
+  my_thread_end();
+}
+
+
+static tpool::thread_pool *get_sql_pool()
+{
+  tpool::thread_pool *pool= sql_pool.load(std::memory_order_acquire);
+  if (likely(pool != nullptr))
+    return pool;
+
+  std::lock_guard<std::mutex> lk(sql_pool_mutex);
+  if (!(pool= sql_pool.load(std::memory_order_relaxed)))
+  {
+#ifdef _WIN32
+    pool= tpool::create_thread_pool_win();
+#else
+    pool= tpool::create_thread_pool_generic();
+#endif
+    pool->set_thread_callbacks(sql_pool_thread_init, sql_pool_thread_end);
+    sql_pool.store(pool, std::memory_order_release);
+  }
+  return pool;
+}
+
+
+namespace
+{
+/** State shared by the tasks of one sql_run_parallel() call */
+struct Parallel_run
+{
+  sql_parallel_func func;
+  void *arg;
+  uint pending;
+  std::mutex mtx;
+  std::condition_variable cv;
+};
+
+struct Parallel_task
+{
+  Parallel_run *run;
+  uint task_no;
+};
+}
+
+
+static void execute_parallel_task(void *arg)
+{
+  Parallel_task *t= static_cast<Parallel_task*>(arg);
+  Parallel_run *run= t->run;
+  run->func(run->arg, t->task_no);
+
+  std::lock_guard<std::mutex> lk(run->mtx);
+  if (!--run->pending)
+    run->cv.notify_one();
+}
+
+
+void sql_run_parallel(uint n_tasks, sql_parallel_func func, void *arg)
+{
+  DBUG_ASSERT(n_tasks >= 1);
+  DBUG_ASSERT(n_tasks <= SQL_PARALLEL_MAX_TASKS);
+
+  if (n_tasks == 1)
+  {
+    func(arg, 0);
+    return;
+  }
+
+  tpool::thread_pool *pool= get_sql_pool();
+  Parallel_run run;
+  Parallel_task args[SQL_PARALLEL_MAX_TASKS];
+  tpool::task tasks[SQL_PARALLEL_MAX_TASKS];
+
+  run.func= func;
+  run.arg= arg;
+  run.pending= n_tasks - 1;
+
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    args[i]= {&run, i};
+    tasks[i]= tpool::task(execute_parallel_task, &args[i]);
+    pool->submit_task(&tasks[i]);
+  }
+
+  func(arg, 0);
+
+  std::unique_lock<std::mutex> lk(run.mtx);
+  while (run.pending)
+    run.cv.wait(lk);
+}
+
+
+void sql_parallel_end()
+{
+  delete sql_pool.exchange(nullptr);
+}
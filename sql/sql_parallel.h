@@ -0,0 +1,52 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef SQL_PARALLEL_INCLUDED
+#define SQL_PARALLEL_INCLUDED
+
+/**
+  @file
+  Intra-query parallelism helpers for the SQL layer.
+
+  The SQL layer shares one tpool instance that is created on first use.
+  Workers have no THD: the work that is handed to them must only touch
+  memory owned by the calling statement and must not raise errors with
+  my_error(). Any failure has to be reported back through the task
+  argument and handled by the caller once sql_run_parallel() returns.
+*/
+
+#include "my_global.h"
+
+/** Upper bound for the number of tasks of one sql_run_parallel() call */
+#define SQL_PARALLEL_MAX_TASKS 64
+
+typedef void (*sql_parallel_func)(void *arg, uint task_no);
+
+/**
+  Run func(arg, 0) ... func(arg, n_tasks - 1) concurrently.
+
+  Task 0 is executed by the calling thread, the rest by the shared worker
+  pool. The function returns after all tasks have finished.
+
+  @param n_tasks  number of tasks, 1 .. SQL_PARALLEL_MAX_TASKS
+  @param func     task body
+  @param arg      argument passed to every task
+*/
+void sql_run_parallel(uint n_tasks, sql_parallel_func func, void *arg);
+
+/** Shut down the worker pool, if it was ever started */
+void sql_parallel_end();
+
+#endif /* SQL_PARALLEL_INCLUDED */
@@ -145,6 +145,8 @@ struct binlog_send_info {
   bool send_fake_gtid_list;
   bool slave_gtid_ignore_duplicates;
   bool using_gtid_state;
+  /* Large row events may be sent with sendfile(), see send_event_zero_copy */
+  bool zero_copy;
 
   int error;
   const char *errmsg;
@@ -179,7 +181,7 @@ struct binlog_send_info {
       gtid_skip_group(GTID_SKIP_NOT), gtid_until_group(GTID_UNTIL_NOT_DONE),
       flags(flags_arg), current_checksum_alg(BINLOG_CHECKSUM_ALG_UNDEF),
       slave_gtid_strict_mode(false), send_fake_gtid_list(false),
-      slave_gtid_ignore_duplicates(false),
+      slave_gtid_ignore_duplicates(false), zero_copy(false),
       error(0),
       errmsg("Unknown error"),
       heartbeat_period(0),
@@ -3226,6 +3228,70 @@ send_event_gtid_list_and_until(binlog_send_info *info, ulong *ev_offset,
 }
 
 
+/*
+  Helper function for send_events(). If the next event in the binlog is a
+  large row event that can be sent unmodified, send it directly from the
+  binlog file with sendfile() instead of reading it into the transmit
+  packet first. Each event is still sent as its own protocol packet; only
+  the packet header, the status byte and the event header go through the
+  net buffer.
+
+  Returns 0 if the event was sent, -1 if the event must be sent the normal
+  way, 1 on error.
+*/
+static int send_event_zero_copy(binlog_send_info *info, IO_CACHE *log,
+                                LOG_INFO *linfo, my_off_t end_pos)
+{
+  uchar head[1 + LOG_EVENT_MINIMAL_HEADER_LEN];
+  ulong ev_offset;
+
+  if (!opt_binlog_dump_sendfile_min_size ||
+      my_b_bytes_in_cache(log) < LOG_EVENT_MINIMAL_HEADER_LEN ||
+      opt_master_verify_checksum || info->fdev->crypto_data.scheme)
+    return -1;
+#ifndef DBUG_OFF
+  if (info->dbug_reconnect_counter > 0)
+    return -1;
+#endif
+
+  const uchar *header= log->read_pos;
+  ulong event_len= uint4korr(header + EVENT_LEN_OFFSET);
+  Log_event_type event_type= (Log_event_type) header[EVENT_TYPE_OFFSET];
+  if (event_len < opt_binlog_dump_sendfile_min_size ||
+      event_len < LOG_EVENT_MINIMAL_HEADER_LEN ||
+      event_len + 1 >= MAX_PACKET_LENGTH ||
+      linfo->pos + event_len > end_pos ||
+      !(LOG_EVENT_IS_WRITE_ROW(event_type) ||
+        LOG_EVENT_IS_UPDATE_ROW(event_type) ||
+        LOG_EVENT_IS_DELETE_ROW(event_type)) ||
+      info->gtid_skip_group != GTID_SKIP_NOT ||
+      ((info->thd->variables.option_bits & OPTION_SKIP_REPLICATION) &&
+       (uint2korr(header + FLAGS_OFFSET) & LOG_EVENT_SKIP_REPLICATION_F)))
+    return -1;
+
+  info->last_pos= linfo->pos;
+  THD_STAGE_INFO(info->thd, stage_sending_binlog_event_to_slave);
+  head[0]= 0;                                   /* OK status byte */
+  memcpy(head + 1, header, LOG_EVENT_MINIMAL_HEADER_LEN);
+  if (my_net_write_file(info->net, head, sizeof(head), log->file,
+                        linfo->pos + LOG_EVENT_MINIMAL_HEADER_LEN,
+                        event_len - LOG_EVENT_MINIMAL_HEADER_LEN))
+  {
+    info->error= ER_UNKNOWN_ERROR;
+    info->errmsg= "Failed on my_net_write_file()";
+    return 1;
+  }
+  statistic_increment(binlog_dump_sendfile_events, &LOCK_status);
+
+  my_b_seek(log, linfo->pos + event_len);
+  linfo->pos= linfo->pos + event_len;
+  if (send_event_gtid_list_and_until(info, &ev_offset, event_type,
+                                     linfo->pos))
+    return 1;
+  return 0;
+}
+
+
 /**
  * This function sends events from one binlog file
  * but only up until end_pos
@@ -3250,6 +3316,14 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
     if (should_stop(info))
       return 0;
 
+    if (info->zero_copy &&
+        (error= send_event_zero_copy(info, log, linfo, end_pos)) >= 0)
+    {
+      if (error)
+        return 1;
+      continue;
+    }
+
     /* reset the transmit packet for the event read from binary log
        file */
     if (reset_transmit_packet(info, info->flags, &ev_offset, &info->errmsg))
@@ -3578,6 +3652,16 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   /* Check if the dump thread is created by a slave with semisync enabled. */
   thd->semi_sync_slave = is_semi_sync_slave();
 
+#ifdef HAVE_SENDFILE
+  /*
+    sendfile() bypasses the net buffer, so it can not be used when the
+    packets are compressed or a semi-sync header is added to each event.
+  */
+  info->zero_copy= !thd->net.compress && !thd->semi_sync_slave &&
+                   (vio_type(thd->net.vio) == VIO_TYPE_TCPIP ||
+                    vio_type(thd->net.vio) == VIO_TYPE_SOCKET);
+#endif
+
   DBUG_ASSERT(pos == linfo.pos);
 
   if (repl_semisync_master.dump_start(thd, linfo.log_file_name, linfo.pos))
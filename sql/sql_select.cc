@@ -61,6 +61,8 @@
 #include "sp_head.h"
 #include "sp_rcontext.h"
 #include "rowid_filter.h"
+#include "filter_kernel.h"
+#include "opt_plan_cache.h"
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
@@ -566,6 +568,7 @@ void JOIN::init(THD *thd_arg, List<Item> &fields_arg,
   in_to_exists_where= NULL;
   in_to_exists_having= NULL;
   emb_sjm_nest= NULL;
+  cached_plan= NULL;
   sjm_lookup_tables= 0;
   sjm_scan_tables= 0;
   is_orig_degenerated= false;
@@ -2192,7 +2195,12 @@ JOIN::init_range_rowid_filters()
       tab->clear_range_rowid_filter();
       continue;
     }
-    tab->table->file->rowid_filter_push(tab->rowid_filter);
+    /*
+      A vector index scan reads rows by position, the filter is checked
+      by the graph search instead of the engine (see join_read_first())
+    */
+    if (!tab->is_using_hlindex())
+      tab->table->file->rowid_filter_push(tab->rowid_filter);
     tab->need_to_build_rowid_filter= true;
   }
   DBUG_RETURN(0);
@@ -6378,7 +6386,12 @@ make_join_statistics(JOIN *join, List<TABLE_LIST> &tables_list,
     /* Find an optimal join order of the non-constant tables. */
     if (join->const_tables != join->table_count)
     {
-      if (choose_plan(join, all_table_map & ~join->const_table_map, 0))
+      bool use_plan_cache= plan_cache_lookup(join);
+      bool res= choose_plan(join, all_table_map & ~join->const_table_map, 0);
+      if (use_plan_cache && !res && !join->cached_plan)
+        plan_cache_store(join);
+      join->cached_plan= NULL;
+      if (res)
         goto error;
 
 #ifdef HAVE_valgrind
@@ -9584,6 +9597,7 @@ best_access_path(JOIN      *join,
   {
     Json_writer_object trace_access_hash(thd);
     double refills, row_copy_cost, copy_cost, cur_cost, where_cost;
+    double scan_cost, spill_cost= 0.0;
     double matching_combinations, fanout= 0.0, join_sel;
     trace_access_hash.add("type", "hash");
     trace_access_hash.add("index", "hj-key");
@@ -9646,8 +9660,32 @@ best_access_path(JOIN      *join,
     refills= (1.0 + floor((double) cache_record_length(join,idx) *
                           record_count /
                           (double) thd->variables.join_buff_size));
+    scan_cost= cur_cost;
     cur_cost= COST_MULT(cur_cost, refills);
 
+    /*
+      With join_cache_spill the join does not refill the buffer but
+      partitions both operands into temporary files (see
+      JOIN_CACHE_BNLH::start_spill()). Then the table is read once and
+      the partial join records and the rows of the table are written to
+      and read from the files once.
+    */
+    if (refills > 1.0 && thd->variables.join_cache_spill &&
+        !(table->map & join->outer_join) && !s->emb_sj_nest)
+    {
+      double spill_bytes= ((double) cache_record_length(join,idx) *
+                           record_count +
+                           rnd_records * table->s->reclength);
+      spill_cost= (scan_cost + TMPFILE_CREATE_COST * 2 +
+                   2.0 * ceil(spill_bytes / IO_SIZE) *
+                   DISK_READ_COST_THD(thd));
+      if (spill_cost < cur_cost)
+      {
+        cur_cost= spill_cost;
+        refills= 1.0;
+      }
+    }
+
     /*
       Cost of doing the hash lookup and check all matching rows with the
       WHERE clause.
@@ -9681,6 +9719,8 @@ best_access_path(JOIN      *join,
         add("extra_cond_check_cost", where_cost).
         add("total_cost", best.cost).
         add("chosen", true);
+    if (unlikely(trace_access_hash.trace_started()) && spill_cost > 0.0)
+      trace_access_hash.add("spill_cost", spill_cost);
   }
 
   /*
@@ -10309,6 +10349,14 @@ choose_plan(JOIN *join, table_map join_tables, TABLE_LIST *emb_sjm_nest)
   {
     optimize_straight_join(join, join_tables);
   }
+  else if (join->cached_plan && !emb_sjm_nest)
+  {
+    /* Use the join order chosen by an earlier execution of the statement */
+    if (unlikely(thd->trace_started()))
+      Json_writer_object(thd).add("cached_join_order", true);
+    plan_cache_restore_order(join);
+    optimize_straight_join(join, join_tables);
+  }
   else
   {
     DBUG_ASSERT(search_depth <= MAX_TABLES + 1);
@@ -16606,6 +16654,11 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
                    str.append(STRING_WITH_LEN("<no_table_name>"));
                  str.append(STRING_WITH_LEN(" final_pushdown_cond"));
                  print_where(tab->select_cond, str.c_ptr_safe(), QT_ORDINARY););
+
+    tab->filter_kernel= NULL;
+    if (statistics && tab->table && tab->select_cond)
+      tab->filter_kernel= Filter_kernel::create(join->thd, tab->table,
+                                                tab->select_cond);
   }
   uint n_top_tables= (uint)(join->join_tab_ranges.head()->end -  
                      join->join_tab_ranges.head()->start);
@@ -24673,7 +24726,17 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_bool());
+    /*
+      The filter kernel rejects most of the rows that do not satisfy the
+      condition without evaluating the Item tree, see filter_kernel.h.
+      It is ignored if select_cond has been replaced after it was built.
+    */
+    if (join_tab->filter_kernel &&
+        join_tab->filter_kernel->get_cond() == select_cond &&
+        join_tab->filter_kernel->rejects())
+      select_cond_result= FALSE;
+    else
+      select_cond_result= MY_TEST(select_cond->val_bool());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -25706,7 +25769,9 @@ join_read_first(JOIN_TAB *tab)
     DBUG_ASSERT(order->item[0]->real_item()->type() == Item::FUNC_ITEM);
     tab->read_record.read_record_func= join_hlindex_read_next;
     error= tab->table->hlindex_read_first(tab->index, *order->item,
-                                          tab->join->select_limit);
+                                          tab->join->select_limit,
+                                          tab->need_to_build_rowid_filter ?
+                                          NULL : tab->rowid_filter);
   }
   else
   {
@@ -27516,6 +27581,62 @@ bool find_indexes_matching_order(JOIN *join, TABLE *table, ORDER *order,
 
 }
 
+/**
+  Use the range access chosen for a table as a rowid filter when the table
+  is read in the order of its vector index.
+
+  The rows of a vector index scan are read by position in the order of
+  the distance, so the range cannot be used to access the table anymore.
+  Instead the graph search only returns rows that are in the filter,
+  see mhnsw_read_first().
+
+  @param tab    the table that will be read using its vector index
+  @param quick  the range select that was chosen to access the table
+
+  @retval true   the rowid filter has been created and owns the quick select
+  @retval false  the quick select cannot be used as a filter
+*/
+
+static bool make_hlindex_rowid_filter(JOIN_TAB *tab, QUICK_SELECT_I *quick)
+{
+  TABLE *table= tab->table;
+  THD *thd= tab->join->thd;
+  int err;
+
+  if (quick->get_type() != QUICK_SELECT_I::QS_TYPE_RANGE ||
+      !table->opt_range_keys.is_set(quick->index))
+    return false;
+
+  Range_rowid_filter_cost_info *info=
+    new (thd->mem_root) Range_rowid_filter_cost_info;
+  if (!info)
+    return false;
+  info->init(SORTED_ARRAY_CONTAINER, table, quick->index);
+  info->is_forced_by_hint= false;
+
+  Rowid_filter_container *container= info->create_container();
+  if (!container)
+    return false;
+  SQL_SELECT *sel= make_select(table, 0, 0, NULL, (SORT_INFO*) 0, 1, &err);
+  if (!sel)
+  {
+    delete container;
+    return false;
+  }
+  sel->quick= quick;
+  if (!(tab->rowid_filter= new (thd->mem_root)
+        Range_rowid_filter(table, info, container, sel)))
+  {
+    sel->quick= 0;
+    delete sel;
+    delete container;
+    return false;
+  }
+  tab->range_rowid_filter_info= info;
+  return true;
+}
+
+
 /**
   Test if we can skip the ORDER BY by using an index.
 
@@ -27872,6 +27993,9 @@ test_if_skip_sort_order(JOIN_TAB *tab,ORDER *order,ha_rows select_limit,
 
       if (!quick_created)
       {
+        if (best_key >= (int) table->s->keys && save_quick &&
+            !tab->rowid_filter && make_hlindex_rowid_filter(tab, save_quick))
+          save_quick= 0;             // Owned by the rowid filter now
         if (select)                  // Throw any existing quick select
           select->quick= 0;          // Cleanup either reset to save_quick,
                                      // or 'delete save_quick'
@@ -30944,6 +31068,7 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
   tracker= &eta->tracker;
   jbuf_tracker= &eta->jbuf_tracker;
   jbuf_loops_tracker= &eta->jbuf_loops_tracker;
+  jbuf_spill_tracker= &eta->jbuf_spill_tracker;
   jbuf_unpack_tracker= &eta->jbuf_unpack_tracker;
 
   /* Enable the table access time tracker only for "ANALYZE stmt" */
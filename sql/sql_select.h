@@ -249,6 +249,7 @@ class AGGR_OP;
 class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
+class Plan_cache_entry;
 
 typedef struct st_join_table {
   TABLE		*table;
@@ -269,6 +270,8 @@ typedef struct st_join_table {
     NULL means no index condition pushdown was performed.
   */
   Item          *pre_idx_push_select_cond;
+  /* Compiled form of the leading conjuncts of select_cond, or NULL */
+  Filter_kernel *filter_kernel;
   /*
     Pointer to the associated ON expression. on_expr_ref=!NULL except for
     degenerate joins. 
@@ -311,6 +314,7 @@ typedef struct st_join_table {
   Table_access_tracker *jbuf_tracker;
   Time_and_counter_tracker *jbuf_unpack_tracker;
   Counter_tracker  *jbuf_loops_tracker;
+  Counter_tracker  *jbuf_spill_tracker;
 
   //  READ_RECORD::Setup_func materialize_table;
   READ_RECORD::Setup_func read_first_record;
@@ -600,6 +604,9 @@ typedef struct st_join_table {
 
   bool build_range_rowid_filter();
   void clear_range_rowid_filter();
+  /* The table is read in the order of its vector index */
+  bool is_using_hlindex() const
+  { return type == JT_NEXT && index >= table->s->keys; }
 
   void cleanup();
   inline bool is_using_loose_index_scan()
@@ -1460,6 +1467,9 @@ class JOIN :public Sql_alloc
     NULL    - otherwise
   */
   TABLE_LIST *emb_sjm_nest;
+
+  /* Join order to use, taken from the plan cache of the SELECT, or NULL */
+  Plan_cache_entry *cached_plan;
   
   /* Current join optimization state */
   POSITION *positions;
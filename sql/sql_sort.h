@@ -573,6 +573,10 @@ class Sort_param {
   ha_rows *accepted_rows;         /* For ROWNUM */
   bool using_pq;
   bool set_all_read_bits;
+  /* Max number of threads to use when sorting a buffer of keys */
+  uint sort_threads;
+  /* Max number of threads that were actually used (for ANALYZE) */
+  uint used_sort_threads;
 
   uchar *unique_buff;
   bool not_killable;
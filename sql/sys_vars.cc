@@ -56,6 +56,7 @@
 #include "log_event.h"
 #include "optimizer_defaults.h"
 #include "vector_mhnsw.h"
+#include "sql_parallel.h"                       // SQL_PARALLEL_MAX_TASKS
 
 #ifdef WITH_PERFSCHEMA_STORAGE_ENGINE
 #include "../storage/perfschema/pfs_server.h"
@@ -2532,6 +2533,26 @@ Sys_slave_parallel_max_queued(
        VALID_RANGE(0,2147483647), DEFAULT(131072), BLOCK_SIZE(1));
 
 
+static bool
+fix_slave_row_prefetch_threads(sys_var *self, THD *thd, enum_var_type type)
+{
+  global_rpl_row_prefetch_pool.resize();
+  return false;
+}
+
+static Sys_var_on_access_global<Sys_var_ulong,
+                           PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_ROW_PREFETCH_THREADS>
+Sys_slave_row_prefetch_threads(
+       "slave_row_prefetch_threads",
+       "If non-zero, number of threads that look up the rows of row-based "
+       "update and delete events before they are applied, so that the "
+       "pages that the applier will access are read concurrently. The rows "
+       "are still modified and committed by a single SQL or worker thread",
+       GLOBAL_VAR(opt_slave_row_prefetch_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0,256), DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+       NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(fix_slave_row_prefetch_threads));
+
+
 bool
 Sys_var_slave_parallel_mode::global_update(THD *thd, set_var *var)
 {
@@ -2750,6 +2771,18 @@ Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                        PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_COMMIT_WAIT_ADAPTIVE>
+Sys_binlog_commit_wait_adaptive(
+       "binlog_commit_wait_adaptive",
+       "Choose the binlog group commit delay from the observed binlog sync "
+       "time and commit rate, using binlog_commit_wait_count and "
+       "binlog_commit_wait_usec as upper limits. No delay is used when "
+       "commits arrive more slowly than the binlog can be synced",
+       GLOBAL_VAR(opt_binlog_commit_wait_adaptive), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2802,6 +2835,14 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(64, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_max_sort_threads(
+       "max_sort_threads",
+       "Maximum number of threads that one filesort may use to sort its "
+       "buffers. Every buffer is split into slices that are sorted "
+       "concurrently and then merged. 1 disables parallel sorting",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, SQL_PARALLEL_MAX_TASKS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -3135,6 +3176,14 @@ static Sys_var_mybool Sys_optimizer_record_context(
     SESSION_VAR(optimizer_record_context), CMD_LINE(OPT_ARG),
     DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_prepared_stmt_plan_cache(
+    "prepared_stmt_plan_cache",
+    "Reuse the join orders chosen by earlier executions of a prepared "
+    "statement when the tables, their statistics and the estimated number "
+    "of rows read from every table are the same",
+    SESSION_VAR(prepared_stmt_plan_cache), CMD_LINE(OPT_ARG),
+    DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_optimizer_adjust_secondary_key_costs(
     "optimizer_adjust_secondary_key_costs",
     UNUSED_HELP,
@@ -3516,6 +3565,14 @@ static Sys_var_ulong Sys_query_cache_min_res_unit(
        BLOCK_SIZE(8), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_qcache_min_res_unit));
 
+static Sys_var_uint Sys_query_cache_instances(
+       "query_cache_instances",
+       "Number of parts the query cache is divided into. Every part has its "
+       "own lock and an equal share of query_cache_size, queries are "
+       "assigned to a part by the hash of their text",
+       READ_ONLY GLOBAL_VAR(query_cache_instances), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, QUERY_CACHE_MAX_INSTANCES), DEFAULT(1), BLOCK_SIZE(1));
+
 static const char *query_cache_type_names[]= { "OFF", "ON", "DEMAND", 0 };
 
 static bool check_query_cache_type(sys_var *self, THD *thd, set_var *var)
@@ -3751,6 +3808,18 @@ Sys_master_verify_checksum(
        GLOBAL_VAR(opt_master_verify_checksum), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_on_access_global<Sys_var_ulong,
+                    PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_DUMP_SENDFILE_MIN_SIZE>
+Sys_binlog_dump_sendfile_min_size(
+       "binlog_dump_sendfile_min_size",
+       "Row events of at least this many bytes are sent to slaves directly "
+       "from the binary log file with sendfile(), without copying them "
+       "through the server. Not used for compressed or semi-sync slave "
+       "connections, encrypted binary logs or with master_verify_checksum. "
+       "0 disables",
+       GLOBAL_VAR(opt_binlog_dump_sendfile_min_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 
 static Sys_var_on_access_global<Sys_var_mybool,
                            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_LEGACY_EVENT_POS>
@@ -4606,6 +4675,15 @@ Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_mybool Sys_threadpool_io_uring(
+  "thread_pool_io_uring",
+  "If set to 1, the thread pool waits for client sockets with io_uring "
+  "instead of epoll. Only supported on Linux, when the server is built "
+  "with liburing",
+  READ_ONLY GLOBAL_VAR(threadpool_io_uring), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE)
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -7142,6 +7220,14 @@ static Sys_var_ulonglong Sys_join_buffer_space_limit(
        VALID_RANGE(2048, ULONGLONG_MAX), DEFAULT(16*128*1024),
        BLOCK_SIZE(2048));
 
+static Sys_var_mybool Sys_join_cache_spill(
+       "join_cache_spill",
+       "When the records of a hash join do not fit into the join buffer, "
+       "partition both join operands into temporary files and join them "
+       "partition by partition instead of refilling the join buffer and "
+       "rescanning the joined table",
+       SESSION_VAR(join_cache_spill), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_progress_report_time(
        "progress_report_time",
        "Seconds between sending progress reports to the client for "
@@ -7293,6 +7379,35 @@ Sys_binlog_gtid_index_span_min(
        VALID_RANGE(1, 1024*1024L*1024L), DEFAULT(65536), BLOCK_SIZE(1));
 
 
+static const char *binlog_transaction_dependency_tracking_names[]=
+  {"COMMIT_ORDER", "WRITESET", NullS};
+static Sys_var_on_access_global<Sys_var_enum,
+           PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_TRACKING>
+Sys_binlog_transaction_dependency_tracking(
+       "binlog_transaction_dependency_tracking",
+       "How the dependencies of transactions are recorded in the binary log "
+       "for parallel replication. COMMIT_ORDER records only which "
+       "transactions group-committed together. WRITESET also records, in "
+       "the GTID event, the last prior transaction that modified any of the "
+       "same rows, so that slave_parallel_mode=optimistic or aggressive can "
+       "wait for exactly that transaction instead of speculating",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_tracking),
+       CMD_LINE(REQUIRED_ARG), binlog_transaction_dependency_tracking_names,
+       DEFAULT(BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+           PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_HISTORY_SIZE>
+Sys_binlog_transaction_dependency_history_size(
+       "binlog_transaction_dependency_history_size",
+       "Maximum number of row hashes that are kept for "
+       "binlog_transaction_dependency_tracking=WRITESET. A transaction that "
+       "modifies more rows depends on the preceding transaction",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_history_size),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 1000000), DEFAULT(25000),
+       BLOCK_SIZE(1));
+
+
 static bool check_pseudo_slave_mode(sys_var *self, THD *thd, set_var *var)
 {
   longlong previous_val= thd->variables.pseudo_slave_mode;
@@ -1864,7 +1864,8 @@ struct TABLE
 
   int hlindex_open(uint nr);
   int hlindex_lock(uint nr);
-  int hlindex_read_first(uint nr, Item *item, ulonglong limit);
+  int hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                         Rowid_filter *filter);
   int hlindex_read_next();
   int hlindex_read_end();
 
@@ -47,6 +47,7 @@ uint threadpool_mode;
 uint threadpool_prio_kickup_timer;
 my_bool threadpool_exact_stats;
 my_bool threadpool_dedicated_listener;
+my_bool threadpool_io_uring;
 
 /* Stats */
 TP_STATISTICS tp_stats;
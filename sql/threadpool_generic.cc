@@ -29,6 +29,10 @@
 #include <sql_plist.h>
 #include <threadpool.h>
 #include <algorithm>
+#ifdef HAVE_URING
+#include <liburing.h>
+#include <poll.h>
+#endif
 #ifdef _WIN32
 #include "threadpool_winsockets.h"
 #define OPTIONAL_IO_POLL_READ_PARAM this
@@ -61,10 +65,16 @@ static bool threadpool_started= false;
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_group_mutex;
 static PSI_mutex_key key_timer_mutex;
+#ifdef HAVE_URING
+static PSI_mutex_key key_uring_mutex;
+#endif
 static PSI_mutex_info mutex_list[]=
 {
   { &key_group_mutex, "group_mutex", 0},
   { &key_timer_mutex, "timer_mutex", PSI_FLAG_GLOBAL}
+#ifdef HAVE_URING
+  ,{ &key_uring_mutex, "uring_mutex", 0}
+#endif
 };
 
 static PSI_cond_key key_worker_cond;
@@ -443,6 +453,232 @@ int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents,
 #endif
 
 
+#ifdef HAVE_URING
+/**
+  io_uring backend, used instead of epoll if thread_pool_io_uring is set.
+
+  Sockets are watched with one-shot IORING_OP_POLL_ADD requests, which
+  have the same semantics as the EPOLLONESHOT registrations above. The
+  difference is in re-arming: epoll needs an epoll_ctl() call for every
+  query, while the poll requests that are prepared while the listener is
+  awake are only queued, and the listener submits all of them with the
+  same io_uring_enter() call that waits for the next completions.
+
+  Requests are queued without being submitted only while uring_deferred
+  is set, that is between the return of the listener from the wait and
+  its next wait, or its leaving the listener loop (see tp_uring_flush()).
+  Thus a queued request is always submitted shortly.
+*/
+
+static bool tp_uring_create(thread_group_t *thread_group)
+{
+  struct io_uring *ring= (struct io_uring *)
+    my_malloc(PSI_INSTRUMENT_ME, sizeof(struct io_uring), MYF(MY_WME));
+  if (!ring)
+    return true;
+  if (int err= io_uring_queue_init(MAX_EVENTS, ring, 0))
+  {
+    sql_print_warning("Threadpool: io_uring_queue_init() failed, errno=%d."
+                      " Using epoll instead", -err);
+    my_free(ring);
+    return true;
+  }
+  mysql_mutex_init(key_uring_mutex, &thread_group->uring_mutex,
+                   MY_MUTEX_INIT_FAST);
+  thread_group->uring= ring;
+  thread_group->uring_pending= 0;
+  thread_group->uring_deferred= false;
+  thread_group->pollfd= ring->ring_fd;
+  return false;
+}
+
+
+static void tp_uring_destroy(thread_group_t *thread_group)
+{
+  io_uring_queue_exit(thread_group->uring);
+  mysql_mutex_destroy(&thread_group->uring_mutex);
+  my_free(thread_group->uring);
+  thread_group->uring= NULL;
+  thread_group->pollfd= INVALID_HANDLE_VALUE;
+}
+
+
+/* Submit the queued requests. uring_mutex must be held. */
+static int tp_uring_submit(thread_group_t *thread_group)
+{
+  mysql_mutex_assert_owner(&thread_group->uring_mutex);
+  while (thread_group->uring_pending)
+  {
+    int ret= io_uring_submit(thread_group->uring);
+    if (ret < 0)
+    {
+      if (ret == -EINTR)
+        continue;
+      errno= -ret;
+      return -1;
+    }
+    thread_group->uring_pending-= MY_MIN((uint) ret,
+                                         thread_group->uring_pending);
+    if (!ret)
+      break;
+  }
+  return 0;
+}
+
+
+/**
+  Watch a socket for readability.
+
+  @param defer  the request may be left in the queue if the listener is
+                going to submit it
+*/
+
+static int tp_uring_start_read(thread_group_t *thread_group, TP_file_handle fd,
+                               void *data, bool defer)
+{
+  int ret= 0;
+  mysql_mutex_lock(&thread_group->uring_mutex);
+  io_uring_sqe *sqe= io_uring_get_sqe(thread_group->uring);
+  if (!sqe)
+  {
+    /* The submission queue is full */
+    tp_uring_submit(thread_group);
+    sqe= io_uring_get_sqe(thread_group->uring);
+  }
+  if (!sqe)
+  {
+    errno= EAGAIN;
+    ret= -1;
+  }
+  else
+  {
+    io_uring_prep_poll_add(sqe, fd, POLLIN | POLLRDHUP);
+    io_uring_sqe_set_data(sqe, data);
+    thread_group->uring_pending++;
+    if (!defer || !thread_group->uring_deferred)
+      ret= tp_uring_submit(thread_group);
+  }
+  mysql_mutex_unlock(&thread_group->uring_mutex);
+  return ret;
+}
+
+
+/**
+  Submit the queued requests and collect the completions.
+
+  The completions are returned as epoll events, so that the rest of the
+  pool does not depend on the backend. A listener (timeout_ms != 0)
+  waits for at least one completion.
+*/
+
+static int tp_uring_wait(thread_group_t *thread_group, native_event *events,
+                         int maxevents, int timeout_ms)
+{
+  DBUG_ASSERT(timeout_ms == 0 || timeout_ms == -1);
+  for (;;)
+  {
+    int cnt= 0;
+    io_uring_cqe *cqe;
+
+    mysql_mutex_lock(&thread_group->uring_mutex);
+    if (timeout_ms)
+      thread_group->uring_deferred= false;
+    tp_uring_submit(thread_group);
+    while (cnt < maxevents && !io_uring_peek_cqe(thread_group->uring, &cqe))
+    {
+      events[cnt].events= cqe->res < 0 ? EPOLLERR : (uint32_t) cqe->res;
+      events[cnt].data.ptr= io_uring_cqe_get_data(cqe);
+      io_uring_cqe_seen(thread_group->uring, cqe);
+      cnt++;
+    }
+    if (cnt || !timeout_ms)
+    {
+      /* The listener is going to handle the events, see listener() */
+      if (cnt && timeout_ms)
+        thread_group->uring_deferred= true;
+      mysql_mutex_unlock(&thread_group->uring_mutex);
+      return cnt;
+    }
+    mysql_mutex_unlock(&thread_group->uring_mutex);
+
+    /*
+      Wait without the mutex, the completions are collected above.
+      Other threads may queue and submit new requests meanwhile.
+    */
+    int err= io_uring_wait_cqe(thread_group->uring, &cqe);
+    if (err && err != -EINTR)
+    {
+      errno= -err;
+      return -1;
+    }
+  }
+}
+
+
+/* Submit the requests that were left for the listener that is leaving */
+static void tp_uring_flush(thread_group_t *thread_group)
+{
+  mysql_mutex_lock(&thread_group->uring_mutex);
+  thread_group->uring_deferred= false;
+  tp_uring_submit(thread_group);
+  mysql_mutex_unlock(&thread_group->uring_mutex);
+}
+#endif /* HAVE_URING */
+
+
+/*
+  Functions used by the pool to watch the sockets of a group. They use
+  the ring of the group if it has one, and io_poll_xxx() otherwise.
+*/
+
+static int group_poll_associate_fd(thread_group_t *thread_group,
+                                   TP_file_handle fd, void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return tp_uring_start_read(thread_group, fd, data, data != NULL);
+#endif
+  return io_poll_associate_fd(thread_group->pollfd, fd, data, opt);
+}
+
+
+static int group_poll_start_read(thread_group_t *thread_group,
+                                 TP_file_handle fd, void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return tp_uring_start_read(thread_group, fd, data, true);
+#endif
+  return io_poll_start_read(thread_group->pollfd, fd, data, opt);
+}
+
+
+static int group_poll_disassociate_fd(thread_group_t *thread_group,
+                                      TP_file_handle fd)
+{
+#ifdef HAVE_URING
+  /*
+    There is no registration to remove: the poll request is completed
+    before a connection is handled, and is not armed again until then.
+  */
+  if (thread_group->uring)
+    return 0;
+#endif
+  return io_poll_disassociate_fd(thread_group->pollfd, fd);
+}
+
+
+static int group_poll_wait(thread_group_t *thread_group, native_event *events,
+                           int maxevents, int timeout_ms)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return tp_uring_wait(thread_group, events, maxevents, timeout_ms);
+#endif
+  return io_poll_wait(thread_group->pollfd, events, maxevents, timeout_ms);
+}
+
+
 /* Dequeue element from a workqueue */
 
 static TP_connection_generic *queue_get(thread_group_t *thread_group)
@@ -734,7 +970,7 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     if (thread_group->shutdown)
       break;
 
-    cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, -1);
+    cnt = group_poll_wait(thread_group, ev, MAX_EVENTS, -1);
     TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::LISTENER]);
     if (cnt <=0)
     {
@@ -833,6 +1069,10 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     mysql_mutex_unlock(&thread_group->mutex);
   }
 
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    tp_uring_flush(thread_group);
+#endif
   DBUG_RETURN(retval);
 }
 PRAGMA_REENABLE_CHECK_STACK_FRAME
@@ -993,6 +1233,9 @@ int thread_group_init(thread_group_t *thread_group, pthread_attr_t* thread_attr)
   thread_group->pthread_attr = thread_attr;
   mysql_mutex_init(key_group_mutex, &thread_group->mutex, NULL);
   thread_group->pollfd= INVALID_HANDLE_VALUE;
+#ifdef HAVE_URING
+  thread_group->uring= NULL;
+#endif
   thread_group->shutdown_pipe[0]= -1;
   thread_group->shutdown_pipe[1]= -1;
   queue_init(thread_group);
@@ -1003,6 +1246,10 @@ int thread_group_init(thread_group_t *thread_group, pthread_attr_t* thread_attr)
 void thread_group_destroy(thread_group_t *thread_group)
 {
   mysql_mutex_destroy(&thread_group->mutex);
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    tp_uring_destroy(thread_group);
+#endif
   if (thread_group->pollfd != INVALID_HANDLE_VALUE)
   {
     io_poll_close(thread_group->pollfd);
@@ -1062,7 +1309,7 @@ static int wake_listener(thread_group_t *thread_group)
   }
 
   /* Wake listener */
-  if (io_poll_associate_fd(thread_group->pollfd,
+  if (group_poll_associate_fd(thread_group,
     thread_group->shutdown_pipe[0], NULL, NULL))
   {
     return -1;
@@ -1218,7 +1465,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     if (!oversubscribed && !threadpool_dedicated_listener)
     {
       native_event ev[MAX_EVENTS];
-      int cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, 0);
+      int cnt = group_poll_wait(thread_group, ev, MAX_EVENTS, 0);
       TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::WORKER]);
       if (cnt > 0)
       {
@@ -1477,7 +1724,7 @@ static int change_group(TP_connection_generic *c,
   mysql_mutex_lock(&old_group->mutex);
   if (c->bound_to_poll_descriptor)
   {
-    io_poll_disassociate_fd(old_group->pollfd,c->fd);
+    group_poll_disassociate_fd(old_group, c->fd);
     c->bound_to_poll_descriptor= false;
   }
   c->thread_group->connection_count--;
@@ -1525,10 +1772,10 @@ int TP_connection_generic::start_io()
   if (!bound_to_poll_descriptor)
   {
     bound_to_poll_descriptor= true;
-    return io_poll_associate_fd(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+    return group_poll_associate_fd(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
   }
 
-  return io_poll_start_read(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+  return group_poll_start_read(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
 }
 
 
@@ -1603,6 +1850,14 @@ int TP_pool_generic::init()
   PSI_register(mutex);
   PSI_register(cond);
   PSI_register(thread);
+#ifndef HAVE_URING
+  if (threadpool_io_uring)
+  {
+    sql_print_warning("Threadpool: thread_pool_io_uring is not supported"
+                      " by this build, using the native poll");
+    threadpool_io_uring= FALSE;
+  }
+#endif
   scheduler_init();
   threadpool_started= true;
   for (uint i= 0; i < threadpool_max_size; i++)
@@ -1664,6 +1919,16 @@ int TP_pool_generic::set_pool_size(uint size)
   {
     thread_group_t *group= &all_groups[i];
     mysql_mutex_lock(&group->mutex);
+#ifdef HAVE_URING
+    /*
+      If io_uring cannot be used, this and all groups that are created
+      later use epoll. Groups that were created earlier keep their rings;
+      the I/O of each group is dispatched through thread_group->uring.
+    */
+    if (group->pollfd == INVALID_HANDLE_VALUE && threadpool_io_uring &&
+        tp_uring_create(group))
+      threadpool_io_uring= FALSE;
+#endif
     if (group->pollfd == INVALID_HANDLE_VALUE)
     {
       group->pollfd= io_poll_create();
@@ -39,6 +39,9 @@ typedef int TP_file_handle;
 #ifdef __linux__
 #include <sys/epoll.h>
 typedef struct epoll_event native_event;
+#ifdef HAVE_URING
+struct io_uring;
+#endif
 #elif defined(HAVE_KQUEUE)
 #include <sys/event.h>
 typedef struct kevent native_event;
@@ -136,6 +139,19 @@ struct thread_group_t
   worker_thread_t* listener;
   pthread_attr_t* pthread_attr;
   TP_file_handle  pollfd;
+#ifdef HAVE_URING
+  /*
+    Ring used instead of epoll if thread_pool_io_uring is set,
+    pollfd is then the descriptor of the ring.
+  */
+  struct io_uring *uring;
+  /* Protects the submission and completion queues of the ring */
+  mysql_mutex_t uring_mutex;
+  /* Number of poll requests that have been queued but not submitted */
+  uint uring_pending;
+  /* Queued requests will be submitted by the listener */
+  bool uring_deferred;
+#endif
   int  thread_count;
   int  active_thread_count;
   int  connection_count;
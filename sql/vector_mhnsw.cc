@@ -23,6 +23,7 @@
 #include <scope.h>
 #include <my_atomic_wrapper.h>
 #include "bloom_filters.h"
+#include "rowid_filter.h"
 
 // distance can be a little bit < 0 because of fast math
 static constexpr float NEAREST = -1.0f;
@@ -111,10 +112,26 @@ static MYSQL_THDVAR_ENUM(default_distance, PLUGIN_VAR_RQCMDARG,
        "Distance function to build the vector index for",
        nullptr, nullptr, EUCLIDEAN, &distances);
 
+/*
+  Precision of the vectors in the index cache. The graph table always
+  stores int16 coordinates, int8 halves the memory needed for the cached
+  vectors at the cost of precision. Search results are then re-ranked
+  using the stored int16 vectors.
+*/
+enum quantization_type : uint { INT16, INT8 };
+static const char *quantization_names[]= { "int16", "int8", nullptr };
+static TYPELIB quantizations= CREATE_TYPELIB_FOR(quantization_names);
+static MYSQL_THDVAR_ENUM(default_quantization, PLUGIN_VAR_RQCMDARG,
+       "Precision of the vectors kept in the vector index cache. int8 "
+       "halves the memory used by cached vectors, search results are "
+       "re-ranked using the full precision vectors",
+       nullptr, nullptr, INT16, &quantizations);
+
 struct ha_index_option_struct
 {
   ulonglong M; // option struct does not support uint
   metric_type metric;
+  quantization_type quantization;
 };
 
 enum Graph_table_fields {
@@ -129,6 +146,9 @@ class FVectorNode;
 
 /*
   One vector, an array of coordinates in ctx->vec_len dimensions
+
+  Coordinates are int16_t, or int8_t (see dims8()) if the index cache
+  is quantized. The graph table always stores the int16_t form.
 */
 #pragma pack(push, 1)
 struct FVector
@@ -140,6 +160,8 @@ struct FVector
   int16_t dims[4];
 
   uchar *data() const { return (uchar*)(&scale); }
+  int8_t *dims8() { return reinterpret_cast<int8_t*>(dims); }
+  const int8_t *dims8() const { return reinterpret_cast<const int8_t*>(dims); }
 
   static size_t data_size(size_t n)
   { return data_header + n*2; }
@@ -147,21 +169,29 @@ struct FVector
   static size_t data_to_value_size(size_t data_size)
   { return (data_size - data_header)*2; }
 
-  static const FVector *create(const MHNSW_Share *ctx, void *mem, const void *src);
+  /* memory for a vector of n coordinates of the given precision */
+  static size_t alloc_size(size_t n, bool int8)
+  { return alloc_size(int8 ? (n + 1)/2 : n); }
+
+  static const FVector *create(const MHNSW_Share *ctx, void *mem,
+                               const void *src, bool int8);
+  void load_int8(const uchar *data, size_t vec_len);
 
-  void postprocess(bool use_subdist, size_t vec_len)
+  void postprocess(bool use_subdist, size_t vec_len, bool int8)
   {
-    int16_t *d= dims;
-    fix_tail(vec_len);
+    size_t from= 0;
+    if (int8)
+      fix_tail8(vec_len);
+    else
+      fix_tail(vec_len);
     if (use_subdist)
     {
-      subabs2= scale * scale * dot_product(d, d, subdist_part) / 2;
-      d+= subdist_part;
-      vec_len-= subdist_part;
+      subabs2= scale * scale * dot(this, 0, subdist_part, int8) / 2;
+      from= subdist_part;
     }
     else
       subabs2= 0;
-    abs2= subabs2 + scale * scale * dot_product(d, d, vec_len) / 2;
+    abs2= subabs2 + scale * scale * dot(this, from, vec_len - from, int8) / 2;
   }
 
 #ifdef AVX2_IMPLEMENTATION
@@ -186,6 +216,23 @@ struct FVector
     return d[0] + d[1] + d[2] + d[3] + d[4] + d[5] + d[6] + d[7];
   }
 
+  AVX2_IMPLEMENTATION
+  static float dot_product8(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    __m256i d= _mm256_setzero_si256();
+    for (size_t i= 0; i < (len + AVX2_dims-1)/AVX2_dims; i++)
+    {
+      __m256i p1= _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)v1 + i));
+      __m256i p2= _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)v2 + i));
+      d= _mm256_add_epi32(d, _mm256_madd_epi16(p1, p2));
+    }
+    __m128i s= _mm_add_epi32(_mm256_castsi256_si128(d),
+                             _mm256_extracti128_si256(d, 1));
+    s= _mm_hadd_epi32(s, s);
+    s= _mm_hadd_epi32(s, s);
+    return static_cast<float>(_mm_cvtsi128_si32(s));
+  }
+
   AVX2_IMPLEMENTATION
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n*2, AVX2_bytes) + AVX2_bytes - 1; }
@@ -200,6 +247,12 @@ struct FVector
   {
     bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX2_dims) - vec_len)*2);
   }
+
+  AVX2_IMPLEMENTATION
+  void fix_tail8(size_t vec_len)
+  {
+    bzero(dims8() + vec_len, MY_ALIGN(vec_len, AVX2_dims) - vec_len);
+  }
 #endif
 
 #ifdef AVX512_IMPLEMENTATION
@@ -219,6 +272,19 @@ struct FVector
     return _mm512_reduce_add_ps(d);
   }
 
+  AVX512_IMPLEMENTATION
+  static float dot_product8(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    __m512i d= _mm512_setzero_si512();
+    for (size_t i= 0; i < (len + AVX512_dims-1)/AVX512_dims; i++)
+    {
+      __m512i p1= _mm512_cvtepi8_epi16(_mm256_loadu_si256((__m256i*)v1 + i));
+      __m512i p2= _mm512_cvtepi8_epi16(_mm256_loadu_si256((__m256i*)v2 + i));
+      d= _mm512_add_epi32(d, _mm512_madd_epi16(p1, p2));
+    }
+    return static_cast<float>(_mm512_reduce_add_epi32(d));
+  }
+
   AVX512_IMPLEMENTATION
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n*2, AVX512_bytes) + AVX512_bytes - 1; }
@@ -233,6 +299,12 @@ struct FVector
   {
     bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX512_dims) - vec_len)*2);
   }
+
+  AVX512_IMPLEMENTATION
+  void fix_tail8(size_t vec_len)
+  {
+    bzero(dims8() + vec_len, MY_ALIGN(vec_len, AVX512_dims) - vec_len);
+  }
 #endif
 
 
@@ -265,6 +337,18 @@ struct FVector
     return static_cast<float>(d);
   }
 
+  static float dot_product8(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32x4_t d= vdupq_n_s32(0);
+    for (size_t i= 0; i < (len + NEON_dims - 1) / NEON_dims; i++)
+    {
+      d= vpadalq_s16(d, vmull_s8(vld1_s8(v1), vld1_s8(v2)));
+      v1+= NEON_dims;
+      v2+= NEON_dims;
+    }
+    return static_cast<float>(vaddvq_s32(d));
+  }
+
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n * 2, NEON_bytes) + NEON_bytes - 1; }
 
@@ -276,6 +360,11 @@ struct FVector
   {
     bzero(dims + vec_len, (MY_ALIGN(vec_len, NEON_dims) - vec_len) * 2);
   }
+
+  void fix_tail8(size_t vec_len)
+  {
+    bzero(dims8() + vec_len, MY_ALIGN(vec_len, NEON_dims) - vec_len);
+  }
 #endif
 
 #ifdef POWER_IMPLEMENTATION
@@ -314,6 +403,23 @@ struct FVector
                               static_cast<int64_t>(ll_sum[1]));
   }
 
+  // one 128-bit load holds POWER_bytes int8 coordinates
+  static float dot_product8(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    vector int sum= {0, 0, 0, 0};
+    size_t base= ((len + POWER_bytes - 1) / POWER_bytes) * POWER_bytes;
+
+    for (size_t i= 0; i < base; i+= POWER_bytes)
+    {
+      vector signed char x= vec_xl(0, (signed char *) &v1[i]);
+      vector signed char y= vec_xl(0, (signed char *) &v2[i]);
+      sum= vec_msum(vec_unpackh(x), vec_unpackh(y), sum);
+      sum= vec_msum(vec_unpackl(x), vec_unpackl(y), sum);
+    }
+
+    return static_cast<float>(sum[0] + sum[1] + sum[2] + sum[3]);
+  }
+
   static size_t alloc_size(size_t n)
   {
     return alloc_header + MY_ALIGN(n * 2, POWER_bytes) + POWER_bytes - 1;
@@ -329,6 +435,11 @@ struct FVector
   {
     bzero(dims + vec_len, (MY_ALIGN(vec_len, POWER_dims) - vec_len) * 2);
   }
+
+  void fix_tail8(size_t vec_len)
+  {
+    bzero(dims8() + vec_len, MY_ALIGN(vec_len, POWER_bytes) - vec_len);
+  }
 #undef DEFAULT_IMPLEMENTATION
 #endif
 
@@ -343,6 +454,15 @@ struct FVector
     return static_cast<float>(d);
   }
 
+  DEFAULT_IMPLEMENTATION
+  static float dot_product8(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32_t d= 0;
+    for (size_t i= 0; i < len; i++)
+      d+= int16_t(v1[i]) * int16_t(v2[i]);
+    return static_cast<float>(d);
+  }
+
   DEFAULT_IMPLEMENTATION
   static size_t alloc_size(size_t n) { return alloc_header + n*2; }
 
@@ -351,24 +471,33 @@ struct FVector
 
   DEFAULT_IMPLEMENTATION
   void fix_tail(size_t) { }
+
+  DEFAULT_IMPLEMENTATION
+  void fix_tail8(size_t) { }
 #endif
 
-  float distance_to(const FVector *other, size_t vec_len) const
+  /* dot product of coordinates from .. from+len-1 */
+  float dot(const FVector *other, size_t from, size_t len, bool int8) const
+  {
+    return int8 ? dot_product8(dims8() + from, other->dims8() + from, len)
+                : dot_product(dims + from, other->dims + from, len);
+  }
+
+  float distance_to(const FVector *other, size_t vec_len, bool int8) const
   {
     return abs2 + other->abs2 - scale * other->scale *
-           dot_product(dims, other->dims, vec_len);
+           dot(other, 0, vec_len, int8);
   }
 
   float distance_greater_than(const FVector *other, size_t vec_len, float than,
-                              Stats *stats) const
+                              Stats *stats, bool int8) const
   {
     float k = scale * other->scale;
-    float dp= dot_product(dims, other->dims, subdist_part);
+    float dp= dot(other, 0, subdist_part, int8);
     float subdist= (subabs2 + other->subabs2 - k * dp)/subdist_part*vec_len;
     if (subdist > than)
       return subdist;
-    dp+= dot_product(dims+subdist_part, other->dims+subdist_part,
-                     vec_len - subdist_part);
+    dp+= dot(other, subdist_part, vec_len - subdist_part, int8);
     float dist= abs2 + other->abs2 - k * dp;
     stats->subdist.add(subdist/dist);
     return dist;
@@ -449,7 +578,7 @@ class FVectorNode
                               Stats *stats) const;
   int load(TABLE *graph);
   int load_from_record(TABLE *graph);
-  int save(TABLE *graph);
+  int save(TABLE *graph, const FVector *exact= nullptr);
   size_t tref_len() const;
   size_t gref_len() const;
   uchar *gref() const;
@@ -490,7 +619,7 @@ class MHNSW_Share : public Sql_alloc
   void *alloc_node_internal()
   {
     return alloc_root(&root, sizeof(FVectorNode) + gref_len + tref_len
-                      + FVector::alloc_size(vec_len));
+                      + FVector::alloc_size(vec_len, int8()));
   }
 
 protected:
@@ -509,12 +638,14 @@ class MHNSW_Share : public Sql_alloc
   const uint gref_len;
   const uint M;
   metric_type metric;
+  quantization_type quantization;
   bool use_subdist;
 
   MHNSW_Share(TABLE *t)
     : tref_len(t->file->ref_length), gref_len(t->hlindex->file->ref_length),
       M(static_cast<uint>(t->s->key_info[t->s->keys].option_struct->M)),
-      metric(t->s->key_info[t->s->keys].option_struct->metric)
+      metric(t->s->key_info[t->s->keys].option_struct->metric),
+      quantization(t->s->key_info[t->s->keys].option_struct->quantization)
   {
     mysql_rwlock_init(PSI_INSTRUMENT_ME, &commit_lock);
     mysql_mutex_init(PSI_INSTRUMENT_ME, &cache_lock, MY_MUTEX_INIT_FAST);
@@ -546,6 +677,9 @@ class MHNSW_Share : public Sql_alloc
     mysql_mutex_unlock(node_lock + ticket);
   }
 
+  /* cached vectors are int8, search results need to be re-ranked */
+  bool int8() const { return quantization == INT8; }
+
   uint max_neighbors(size_t layer) const
   {
     return (layer ? 1 : 2) * M; // heuristic from the paper
@@ -895,19 +1029,25 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
   return 0;
 }
 
-const FVector *FVector::create(const MHNSW_Share *ctx, void *mem, const void *src)
+const FVector *FVector::create(const MHNSW_Share *ctx, void *mem,
+                               const void *src, bool int8)
 {
+  const float max_dim= int8 ? 127 : 32767;
   float scale=0, *v= (float *)src;
   for (size_t i= 0; i < ctx->vec_len; i++)
     scale= std::max(scale, std::abs(get_float(v + i)));
 
   FVector *vec= align_ptr(mem);
-  vec->scale= scale ? scale/32767 : 1;
-  if (std::round(scale/vec->scale) > 32767)
+  vec->scale= scale ? scale/max_dim : 1;
+  if (std::round(scale/vec->scale) > max_dim)
     vec->scale= std::nextafter(vec->scale, FLT_MAX);
-  for (size_t i= 0; i < ctx->vec_len; i++)
-    vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
-  vec->postprocess(ctx->use_subdist, ctx->vec_len);
+  if (int8)
+    for (size_t i= 0; i < ctx->vec_len; i++)
+      vec->dims8()[i]= static_cast<int8_t>(std::round(get_float(v + i) / vec->scale));
+  else
+    for (size_t i= 0; i < ctx->vec_len; i++)
+      vec->dims[i]= static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
+  vec->postprocess(ctx->use_subdist, ctx->vec_len, int8);
   if (ctx->metric == COSINE)
   {
     if (vec->abs2 > 0.0f)
@@ -920,10 +1060,36 @@ const FVector *FVector::create(const MHNSW_Share *ctx, void *mem, const void *sr
   return vec;
 }
 
+/*
+  convert a vector as stored in the graph table to int8.
+  abs2 and subabs2 are set by the caller with postprocess()
+*/
+void FVector::load_int8(const uchar *data, size_t vec_len)
+{
+  const uchar *src= data + data_header;
+  int max_dim= 0;
+  for (size_t i= 0; i < vec_len; i++)
+  {
+    int16_t d;
+    memcpy(&d, src + i*2, sizeof(d));
+    max_dim= std::max(max_dim, std::abs(int(d)));
+  }
+
+  memcpy(&scale, data, sizeof(scale));
+  if (max_dim)
+    scale*= max_dim/127.0f;
+  for (size_t i= 0; i < vec_len; i++)
+  {
+    int16_t d;
+    memcpy(&d, src + i*2, sizeof(d));
+    dims8()[i]= max_dim ? static_cast<int8_t>(std::round(d*127.0f/max_dim)) : 0;
+  }
+}
+
 /* copy the vector, preprocessed as needed */
 const FVector *FVectorNode::make_vec(const void *v)
 {
-  return FVector::create(ctx, tref() + tref_len(), v);
+  return FVector::create(ctx, tref() + tref_len(), v, ctx->int8());
 }
 
 FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *gref_)
@@ -946,7 +1112,7 @@ FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
 
 float FVectorNode::distance_to(const FVector *other) const
 {
-  return vec->distance_to(other, ctx->vec_len);
+  return vec->distance_to(other, ctx->vec_len, ctx->int8());
 }
 
 float FVectorNode::distance_greater_than(const FVector *other, float than,
@@ -956,7 +1122,7 @@ float FVectorNode::distance_greater_than(const FVector *other, float than,
   if (mode == NOSTAT_NOSUBDIST)
     return distance_to(other);
   return vec->distance_greater_than(other, ctx->vec_len,
-                                    than*mul[mode], stats);
+                                    than*mul[mode], stats, ctx->int8());
 }
 
 int FVectorNode::alloc_neighborhood(uint8_t layer)
@@ -1010,8 +1176,11 @@ int FVectorNode::load_from_record(TABLE *graph)
   if (v->length() != FVector::data_size(ctx->vec_len))
     return my_errno= HA_ERR_CRASHED;
   FVector *vec_ptr= FVector::align_ptr(tref() + tref_len());
-  memcpy(vec_ptr->data(), v->ptr(), v->length());
-  vec_ptr->postprocess(ctx->use_subdist, ctx->vec_len);
+  if (ctx->int8())
+    vec_ptr->load_int8((const uchar*) v->ptr(), ctx->vec_len);
+  else
+    memcpy(vec_ptr->data(), v->ptr(), v->length());
+  vec_ptr->postprocess(ctx->use_subdist, ctx->vec_len, ctx->int8());
 
   longlong layer= graph->field[FIELD_LAYER]->val_int();
   if (layer > 100) // 10e30 nodes at M=2, more at larger M's
@@ -1068,6 +1237,7 @@ struct MHNSW_param
   Stats acc;
   dgt_mode mode;
   double max_est_size;
+  Rowid_filter *filter= nullptr;  // rows of the base table to return
   MHNSW_param(MHNSW_Share *ctx, TABLE *graph, int layer)
     : ctx(ctx), graph(graph), layer(layer)
   {
@@ -1087,6 +1257,11 @@ struct MHNSW_param
     else
       mode= NOSTAT_NOSUBDIST;
   }
+  /* the node can be traversed, but not returned */
+  bool skip(const FVectorNode *node) const
+  {
+    return node->deleted || (filter && !filter->check((char*) node->tref()));
+  }
 };
 
 /* one visited node during the search. caches the distance to target */
@@ -1199,12 +1374,28 @@ static int select_neighbors(MHNSW_param *p, FVectorNode *target,
 }
 
 
-int FVectorNode::save(TABLE *graph)
+/*
+  @param exact   the int16 vector of a new node, when the cached one is int8.
+                 Stored nodes keep the vector that is already in the row.
+*/
+int FVectorNode::save(TABLE *graph, const FVector *exact)
 {
   DBUG_ASSERT(vec);
   DBUG_ASSERT(neighbors);
+  DBUG_ASSERT(stored || !ctx->int8() || exact);
 
-  restore_record(graph, s->default_values);
+  int err;
+  if (stored && (err= graph->file->ha_rnd_pos(graph->record[1], gref())))
+    return err;
+
+  if (stored && ctx->int8())
+    restore_record(graph, record[1]);
+  else
+  {
+    restore_record(graph, s->default_values);
+    graph->field[FIELD_VEC]->store_binary((exact ? exact : vec)->data(),
+                                          FVector::data_size(ctx->vec_len));
+  }
   graph->field[FIELD_LAYER]->store(max_layer, false);
   if (deleted)
     graph->field[FIELD_TREF]->set_null();
@@ -1213,7 +1404,6 @@ int FVectorNode::save(TABLE *graph)
     graph->field[FIELD_TREF]->set_notnull();
     graph->field[FIELD_TREF]->store_binary(tref(), tref_len());
   }
-  graph->field[FIELD_VEC]->store_binary(vec->data(), FVector::data_size(ctx->vec_len));
 
   size_t total_size= 0;
   for (size_t i=0; i <= max_layer; i++)
@@ -1229,15 +1419,11 @@ int FVectorNode::save(TABLE *graph)
   }
   graph->field[FIELD_NEIGHBORS]->store_binary(neighbor_blob, total_size);
 
-  int err;
   if (stored)
   {
-    if (!(err= graph->file->ha_rnd_pos(graph->record[1], gref())))
-    {
-      err= graph->file->ha_update_row(graph->record[1], graph->record[0]);
-      if (err == HA_ERR_RECORD_IS_THE_SAME)
-        err= 0;
-    }
+    err= graph->file->ha_update_row(graph->record[1], graph->record[0]);
+    if (err == HA_ERR_RECORD_IS_THE_SAME)
+      err= 0;
   }
   else
   {
@@ -1292,7 +1478,7 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
 
   MEM_ROOT * const root= p->graph->in_use->mem_root;
   Queue<Visited> candidates, best;
-  bool skip_deleted;
+  bool skip_deleted;             // skip deleted and filtered out nodes
   uint ef= result_size;
   const float generosity= 1.1f + p->ctx->M/500.0f;
 
@@ -1325,7 +1511,7 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
     Visited *v= visited.create(node, node->distance_to(target));
     p->acc.diameter= std::max(p->acc.diameter, v->distance_to_target);
     candidates.push(v);
-    if ((skip_deleted && v->node->deleted) || threshold > NEAREST)
+    if ((skip_deleted && p->skip(v->node)) || threshold > NEAREST)
       continue;
     best.push(v);
   }
@@ -1361,7 +1547,7 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
             continue;
           p->acc.diameter= std::max(p->acc.diameter, v->distance_to_target);
           candidates.safe_push(v);
-          if (skip_deleted && v->node->deleted)
+          if (skip_deleted && p->skip(v->node))
             continue;
           best.push(v);
           furthest_best= generous_furthest(best, p->acc.diameter, generosity);
@@ -1376,7 +1562,7 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
           if (v->distance_to_target < furthest_best)
           {
             candidates.safe_push(v);
-            if (skip_deleted && v->node->deleted)
+            if (skip_deleted && p->skip(v->node))
               continue;
             if (v->distance_to_target < best.top()->distance_to_target)
             {
@@ -1405,6 +1591,110 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
 }
 
 
+/*
+  sort the search result by the exact distance to the target
+
+  used when the cached vectors are int8, the distances are calculated
+  with the int16 vectors from the graph table
+*/
+static int rerank(MHNSW_param *p, const FVector *exact, Neighborhood *found)
+{
+  MHNSW_Share * const ctx= p->ctx;
+  TABLE * const graph= p->graph;
+  MEM_ROOT * const root= graph->in_use->mem_root;
+  Queue<Visited> pq;
+
+  if (!found->num)
+    return 0;
+  if (pq.init(static_cast<uint>(found->num), true, Visited::cmp))
+    return my_errno= HA_ERR_OUT_OF_MEM;
+
+  FVector *vec= FVector::align_ptr(alloc_root(root,
+                                   FVector::alloc_size(ctx->vec_len, false)));
+  for (size_t i=0; i < found->num; i++)
+  {
+    FVectorNode *node= found->links[i];
+    if (int err= graph->file->ha_rnd_pos(graph->record[0], node->gref()))
+      return err;
+    String buf, *v= graph->field[FIELD_VEC]->val_str(&buf);
+    if (unlikely(!v || v->length() != FVector::data_size(ctx->vec_len)))
+      return my_errno= HA_ERR_CRASHED;
+    memcpy(vec->data(), v->ptr(), v->length());
+    vec->postprocess(ctx->use_subdist, ctx->vec_len, false);
+    pq.push(new (root) Visited(node, vec->distance_to(exact, ctx->vec_len,
+                                                      false)));
+  }
+
+  for (FVectorNode **links= found->links + found->num; pq.elements();)
+    *--links= pq.pop()->node;
+  return 0;
+}
+
+/*
+  find the nearest rows of the filter by calculating the distance to
+  every one of them. used when the filter is too selective for the graph
+  search, that would have to traverse most of the graph to find them.
+*/
+static int search_filter(MHNSW_param *p, const FVector *target,
+                         Rowid_filter_sorted_array *rows, uint limit,
+                         Neighborhood *found)
+{
+  MHNSW_Share * const ctx= p->ctx;
+  TABLE * const graph= p->graph;
+  MEM_ROOT * const root= graph->in_use->mem_root;
+  const uint tref_len= ctx->tref_len;
+  Queue<Visited> pq;
+
+  found->num= 0;
+  if (!rows->elements())
+    return 0;
+  if (pq.init(limit, true, Visited::cmp))
+    return my_errno= HA_ERR_OUT_OF_MEM;
+
+  uchar *key= (uchar*)alloca(graph->key_info[IDX_TREF].key_length);
+  graph->field[FIELD_TREF]->set_notnull();
+  for (uint i=0; i < rows->elements(); i++)
+  {
+    graph->field[FIELD_TREF]->store_binary(rows->get_pos(i), tref_len);
+    key_copy(key, graph->record[0], &graph->key_info[IDX_TREF],
+             graph->key_info[IDX_TREF].key_length);
+    int err= graph->file->ha_index_read_idx_map(graph->record[0], IDX_TREF,
+                                 key, HA_WHOLE_KEY, HA_READ_KEY_EXACT);
+    if (err == HA_ERR_KEY_NOT_FOUND)
+      continue;
+    if (err)
+      return err;
+    graph->file->position(graph->record[0]);
+    FVectorNode *node= ctx->get_node(graph->file->ref);
+    if (!node)
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    if ((err= node->load_from_record(graph)))
+      return err;
+    if (node->deleted)
+      continue;
+    Visited *v= new (root) Visited(node, node->distance_to(target));
+    if (!pq.is_full())
+      pq.push(v);
+    else if (v->distance_to_target < pq.top()->distance_to_target)
+      pq.replace_top(v);
+  }
+
+  found->num= pq.elements();
+  for (FVectorNode **links= found->links + found->num; pq.elements();)
+    *--links= pq.pop()->node;
+  return 0;
+}
+
+/* the vector to store in the graph table, if the cached one is int8 */
+static const FVector *make_exact_vec(MHNSW_Share *ctx, THD *thd, const void *src)
+{
+  if (!ctx->int8())
+    return nullptr;
+  return FVector::create(ctx, thd->alloc(FVector::alloc_size(ctx->vec_len, false)),
+                         src, false);
+}
+
+
 int mhnsw_insert(TABLE *table, KEY *keyinfo)
 {
   THD *thd= table->in_use;
@@ -1428,6 +1718,11 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
 
   int err= MHNSW_Share::acquire(&ctx, table, true);
   SCOPE_EXIT([ctx, table](){ ctx->release(table); });
+
+  MEM_ROOT_SAVEPOINT memroot_sv;
+  root_make_savepoint(thd->mem_root, &memroot_sv);
+  SCOPE_EXIT([memroot_sv](){ root_free_to_savepoint(&memroot_sv); });
+
   if (err)
   {
     if (err != HA_ERR_END_OF_FILE)
@@ -1437,7 +1732,7 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
     ctx->set_lengths(res->length());
     FVectorNode *target= new (ctx->alloc_node())
                    FVectorNode(ctx, table->file->ref, 0, res->ptr());
-    if (!((err= target->save(graph))))
+    if (!((err= target->save(graph, make_exact_vec(ctx, thd, res->ptr())))))
       ctx->start= target;
     return err;
   }
@@ -1445,10 +1740,6 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
   if (ctx->byte_len != res->length())
     return my_errno= HA_ERR_CRASHED;
 
-  MEM_ROOT_SAVEPOINT memroot_sv;
-  root_make_savepoint(thd->mem_root, &memroot_sv);
-  SCOPE_EXIT([memroot_sv](){ root_free_to_savepoint(&memroot_sv); });
-
   const size_t max_found= ctx->max_neighbors(0);
   Neighborhood candidates;
   candidates.init(thd->alloc<FVectorNode*>(max_found + 7), max_found);
@@ -1486,7 +1777,7 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
       return err;
   }
 
-  if (int err= target->save(graph))
+  if (int err= target->save(graph, make_exact_vec(ctx, thd, res->ptr())))
     return err;
   ctx->add_to_stats(p.acc);
 
@@ -1510,15 +1801,26 @@ struct Search_context: public Sql_alloc
   Neighborhood found;
   MHNSW_Share *ctx;
   const FVector *target;
+  const FVector *exact;         // int16 target to re-rank with, or nullptr
+  Rowid_filter *filter;
+  bool complete;                // all rows of the filter are in found
   ulonglong ctx_version;
   size_t pos= 0;
   float threshold= NEAREST/2;
-  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v)
-    : found(*n), ctx(s->dup(false)), target(v), ctx_version(ctx->version) {}
+  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v,
+                 const FVector *e, Rowid_filter *f, bool c)
+    : found(*n), ctx(s->dup(false)), target(v), exact(e), filter(f),
+      complete(c), ctx_version(ctx->version) {}
 };
 
 
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
+/*
+  The filter, if any, contains the rows that satisfy the range condition
+  on the base table. Only these rows are returned by the graph search.
+  If there are few enough of them, all are compared to the target instead.
+*/
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Rowid_filter *filter)
 {
   THD *thd= table->in_use;
   TABLE *graph= table->hlindex;
@@ -1538,6 +1840,31 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   if (err)
     return err;
 
+  /*
+    quantized distances only approximate the order of the nodes,
+    take at least ef_search of them and re-rank them all
+  */
+  if (ctx->int8())
+    limit= std::max<ulonglong>(limit, THDVAR(thd, ef_search));
+
+  /*
+    the graph search visits about ef*N/n nodes to find ef nodes out of n
+    in the filter. when this is more than n, brute force is cheaper
+  */
+  Rowid_filter_sorted_array *rows= nullptr;
+  if (filter && filter->get_container()->get_type() == SORTED_ARRAY_CONTAINER)
+  {
+    Stats stats;
+    ctx->read_stats(&stats);
+    ulonglong n= filter->get_container()->elements();
+    ulonglong ef= std::max<ulonglong>(limit, THDVAR(thd, ef_search));
+    if (n <= max_ef && n * n <= ef * stats.graph_size)
+    {
+      rows= static_cast<Rowid_filter_sorted_array*>(filter->get_container());
+      limit= std::max(limit, n);
+    }
+  }
+
   Neighborhood candidates;
   candidates.init(thd->alloc<FVectorNode*>(limit + 7), limit);
 
@@ -1559,32 +1886,56 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
       ((float*)buf.ptr())[i]= i == 0;
   }
 
-  auto target= FVector::create(ctx, thd->alloc(FVector::alloc_size(ctx->vec_len)),
-                               res->ptr());
-
-  if (int err= graph->file->ha_rnd_init(0))
-    return err;
+  auto target= FVector::create(ctx,
+                 thd->alloc(FVector::alloc_size(ctx->vec_len, ctx->int8())),
+                 res->ptr(), ctx->int8());
+  auto exact= make_exact_vec(ctx, thd, res->ptr());
 
   MHNSW_param p(ctx, graph, candidates.links[0]->max_layer);
 
-  for (; p.layer > 0; p.layer--)
+  if (rows)
   {
-    if (int err= search_layer(&p, target, NEAREST, 1, &candidates, false))
+    if (int err= search_filter(&p, target, rows, static_cast<uint>(limit),
+                                 &candidates))
+      return err;
+    if (int err= graph->file->ha_rnd_init(0))
+      return err;
+  }
+  else
+  {
+    if (int err= graph->file->ha_rnd_init(0))
+      return err;
+
+    p.filter= filter;
+    for (; p.layer > 0; p.layer--)
+    {
+      if (int err= search_layer(&p, target, NEAREST, 1, &candidates, false))
+      {
+        graph->file->ha_rnd_end();
+        return err;
+      }
+    }
+
+    if (int err= search_layer(&p, target, NEAREST, static_cast<uint>(limit),
+                              &candidates, false))
     {
       graph->file->ha_rnd_end();
       return err;
     }
+    ctx->add_to_stats(p.acc);
   }
 
-  if (int err= search_layer(&p, target, NEAREST, static_cast<uint>(limit),
-                            &candidates, false))
+  if (exact)
   {
-    graph->file->ha_rnd_end();
-    return err;
+    if (int err= rerank(&p, exact, &candidates))
+    {
+      graph->file->ha_rnd_end();
+      return err;
+    }
   }
-  ctx->add_to_stats(p.acc);
 
-  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target);
+  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target,
+                                                  exact, filter, rows);
   graph->context= result;
 
   return mhnsw_read_next(table);
@@ -1598,7 +1949,7 @@ int mhnsw_read_next(TABLE *table)
     uchar *ref= result->found.links[result->pos++]->tref();
     return table->file->ha_rnd_pos(table->record[0], ref);
   }
-  if (!result->found.num)
+  if (!result->found.num || result->complete)
     return my_errno= HA_ERR_END_OF_FILE;
 
   TABLE *graph= table->hlindex;
@@ -1632,10 +1983,20 @@ int mhnsw_read_next(TABLE *table)
   }
 
   float new_threshold= result->found.links[result->found.num-1]->distance_to(result->target);
+  if (result->exact) // re-ranked, the last node is not always the furthest
+    for (size_t i=0; i < result->found.num - 1; i++)
+      new_threshold= std::max(new_threshold,
+                       result->found.links[i]->distance_to(result->target));
   MHNSW_param p(ctx, graph, 0);
+  p.filter= result->filter;
   if (int err= search_layer(&p, result->target, result->threshold,
                             static_cast<uint>(result->pos), &result->found, false))
     return err;
+  if (result->exact)
+  {
+    if (int err= rerank(&p, result->exact, &result->found))
+      return err;
+  }
   result->pos= 0;
   result->threshold= new_threshold + FLT_EPSILON;
   return mhnsw_read_next(table);
@@ -1762,6 +2123,7 @@ ha_create_table_option mhnsw_index_options[]=
 {
   HA_IOPTION_SYSVAR("m", M, default_m),
   HA_IOPTION_SYSVAR("distance", metric, default_distance),
+  HA_IOPTION_SYSVAR("quantization", quantization, default_quantization),
   HA_IOPTION_END
 };
 
@@ -1791,6 +2153,7 @@ static struct st_mysql_sys_var *mhnsw_sys_vars[]=
   MYSQL_SYSVAR(max_cache_size),
   MYSQL_SYSVAR(default_m),
   MYSQL_SYSVAR(default_distance),
+  MYSQL_SYSVAR(default_quantization),
   MYSQL_SYSVAR(ef_search),
   NULL
 };
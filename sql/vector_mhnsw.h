@@ -21,13 +21,16 @@
 #include "structs.h"
 #include "table.h"
 
+class Rowid_filter;
+
 /*
   This will become a vector index plugin API, or, perhaps,
   a hlindex plugin API. When we'll have more than one implementation.
 */
 const LEX_CSTRING mhnsw_hlindex_table_def(THD *thd, uint ref_length);
 int mhnsw_insert(TABLE *table, KEY *keyinfo);
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit);
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Rowid_filter *filter);
 int mhnsw_read_next(TABLE *table);
 int mhnsw_read_end(TABLE *table);
 int mhnsw_invalidate(TABLE *table, const uchar *rec, KEY *keyinfo);
@@ -476,6 +476,141 @@ btr_pcur_t::restore_position(btr_latch_mode restore_latch_mode, mtr_t *mtr)
 	return ret_val;
 }
 
+/** Look up the leaf pages that follow a leaf page in the index.
+The tree is searched for the first record of the page down to the level
+above the leaves, where the node pointers that follow the one for the page
+point to the next leaf pages. Because the caller is holding a latch on the
+leaf page, we must not wait for any latches on the upper levels of the
+tree. If any page is not available immediately, we give up.
+@param index  B-tree index
+@param block  latched leaf page
+@param pages  the next leaf page numbers
+@param n      maximum number of pages
+@return number of page numbers returned in pages[] */
+static uint32_t btr_pcur_next_leaves(const dict_index_t &index,
+                                     const buf_block_t &block,
+                                     uint32_t *pages, uint32_t n) noexcept
+{
+  const page_t *leaf= block.page.frame;
+  const rec_t *rec= page_rec_get_next_const(page_get_infimum_rec(leaf));
+  if (!rec || page_rec_is_supremum(rec))
+    return 0;
+
+  mem_heap_t *heap= mem_heap_create(256);
+  const dtuple_t *tuple=
+    dict_index_build_data_tuple(rec, &index, true,
+                                dict_index_get_n_unique_in_tree(&index), heap);
+  rec_offs *offsets= nullptr;
+  uint32_t found= 0;
+  page_id_t id{block.page.id().space(), index.page};
+
+  for (ulint height= ULINT_UNDEFINED;;)
+  {
+    buf_block_t *b= buf_pool.page_fix(id, nullptr, nullptr,
+                                      buf_pool_t::FIX_NOWAIT);
+    if (!b || b == reinterpret_cast<buf_block_t*>(-1))
+      break;
+    if (!b->page.lock.s_lock_try())
+    {
+      b->page.unfix();
+      break;
+    }
+
+    const page_t *page= b->page.frame;
+    const ulint level= btr_page_get_level(page);
+    page_cur_t cur;
+    cur.index= const_cast<dict_index_t*>(&index);
+    cur.block= b;
+    uint16_t up_match= 0, low_match= 0;
+    bool ok= level && (height == ULINT_UNDEFINED || level == height) &&
+      btr_page_get_index_id(page) == index.id &&
+      fil_page_index_page_check(page) &&
+      !!page_is_comp(page) == index.table->not_redundant() &&
+      !page_cur_search_with_match(tuple, PAGE_CUR_LE, &up_match, &low_match,
+                                  &cur, nullptr) &&
+      page_rec_is_user_rec(cur.rec);
+    if (ok)
+    {
+      offsets= rec_get_offsets(cur.rec, &index, offsets, 0, ULINT_UNDEFINED,
+                               &heap);
+      id.set_page_no(btr_node_ptr_get_child_page_no(cur.rec, offsets));
+      if (level == 1)
+      {
+        /* The node pointer must point to our page; otherwise the tree
+        has been reorganized since our page was latched. */
+        if (id != block.page.id())
+          ok= false;
+        else
+          for (const rec_t *r= cur.rec; found < n; )
+          {
+            r= page_rec_get_next_const(r);
+            if (!r || !page_rec_is_user_rec(r))
+              break;
+            offsets= rec_get_offsets(r, &index, offsets, 0, ULINT_UNDEFINED,
+                                     &heap);
+            pages[found++]= btr_node_ptr_get_child_page_no(r, offsets);
+          }
+      }
+    }
+
+    b->page.lock.s_unlock();
+    b->page.unfix();
+    if (!ok || level == 1)
+      break;
+    height= level - 1;
+  }
+
+  mem_heap_free(heap);
+  return found;
+}
+
+/** Read ahead the leaf pages that follow a page in an ascending index scan.
+The depth of the read-ahead is doubled whenever the scan has to wait for
+a page to be read.
+@param cursor   persistent cursor that was moved to the next page
+@param block    the next page, accessed for the first time
+@param was_read whether the page had to be read on demand */
+static void btr_pcur_read_ahead(btr_pcur_t *cursor, const buf_block_t &block,
+                                bool was_read) noexcept
+{
+  const uint32_t max_depth= srv_read_ahead_scan_depth;
+  if (!max_depth)
+    return;
+
+  if (was_read)
+  {
+    buf_pool.scan_read_ahead_misses++;
+    cursor->read_ahead_depth= cursor->read_ahead_depth
+      ? std::min(2 * cursor->read_ahead_depth, max_depth)
+      : std::min(4U, max_depth);
+    cursor->read_ahead_pending= 0;
+  }
+  else
+  {
+    buf_pool.scan_read_ahead_hits++;
+    if (!cursor->read_ahead_depth)
+      return;
+    cursor->read_ahead_depth= std::min(cursor->read_ahead_depth, max_depth);
+    if (cursor->read_ahead_pending)
+      cursor->read_ahead_pending--;
+    /* Keep at least half of the window in flight. */
+    if (cursor->read_ahead_pending > cursor->read_ahead_depth / 2)
+      return;
+  }
+
+  const dict_index_t &index= *cursor->index();
+  if (index.is_spatial() || index.page == FIL_NULL)
+    return;
+
+  /* innodb_read_ahead_scan_depth is at most 256 */
+  uint32_t pages[256];
+  const uint32_t n= btr_pcur_next_leaves(index, block, pages,
+                                         cursor->read_ahead_depth);
+  if (n)
+    buf_read_ahead_scan(block.page.id().space(), pages, n);
+  cursor->read_ahead_pending= n;
+}
+
 /*********************************************************//**
 Moves the persistent cursor to the first record on the next page. Releases the
 latch on the current page, and bufferunfixes it. Note that there must not be
@@ -511,6 +646,11 @@ btr_pcur_move_to_next_page(
 
 	dberr_t err;
 	bool first_access = false;
+	const page_id_t next_id(btr_pcur_get_block(cursor)->page.id().space(),
+				next_page_no);
+	const bool was_read = srv_read_ahead_scan_depth
+		&& !buf_pool.page_hash_contains(
+			next_id, buf_pool.page_hash.cell_get(next_id.fold()));
 	buf_block_t* next_block = btr_block_get(
 		*cursor->index(), next_page_no,
 		rw_lock_type_t(cursor->latch_mode & (RW_X_LATCH | RW_S_LATCH)),
@@ -535,6 +675,7 @@ btr_pcur_move_to_next_page(
 	mtr->rollback_to_savepoint(s - 2, s - 1);
 	if (first_access) {
 		buf_read_ahead_linear(next_block->page.id());
+		btr_pcur_read_ahead(cursor, *next_block, was_read);
 	}
 	return DB_SUCCESS;
 }
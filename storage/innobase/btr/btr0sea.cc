@@ -177,6 +177,77 @@ static constexpr unsigned BTR_SEARCH_PAGE_BUILD_LIMIT= 16;
 before hash index building is started */
 static constexpr uint8_t BTR_SEARCH_BUILD_LIMIT= 100;
 
+/** One in this many searches and modifications of a thread is sampled
+for the admission decision and the counters of the index */
+static constexpr uint32_t BTR_SEARCH_SAMPLE_RATE= 16;
+
+/** Number of sampled searches and modifications of an index after which
+btr_search_admit() reconsiders whether the adaptive hash index is useful;
+this corresponds to about 4096 searches and modifications */
+static constexpr uint32_t BTR_SEARCH_ADMISSION_WINDOW=
+  4096 / BTR_SEARCH_SAMPLE_RATE;
+
+/** Searches and modifications by this thread, for btr_search_sampled() */
+static thread_local uint32_t btr_search_sample_tick;
+
+/** @return whether the current search or modification is to be sampled.
+Only sampled events write to the search info of the index, so that the
+threads that use the adaptive hash index do not contend for its cache
+line on each search. */
+static inline bool btr_search_sampled() noexcept
+{
+  return !(++btr_search_sample_tick % BTR_SEARCH_SAMPLE_RATE);
+}
+
+/** Decide at the end of a sampling window whether the adaptive hash index
+is worth maintaining for an index. The index is excluded when modifications
+of its hashed pages clearly outnumber the searches that the adaptive hash
+index satisfied. It is admitted again when more searches could have used
+the adaptive hash index than there were modifications.
+@param info  search info of the index */
+ATTRIBUTE_NOINLINE
+static void btr_search_admit(dict_index_t::ahi &info) noexcept
+{
+  const uint32_t hits= info.window_hits.exchange(0);
+  const uint32_t maintenance= info.window_maintenance.exchange(0);
+  if (!info.excluded)
+    info.excluded= maintenance > 2 * hits;
+  else
+    info.excluded= hits <= maintenance;
+}
+
+/** Count one sampled event of an index.
+@param info    search info of the index
+@param counter info.window_hits or info.window_maintenance */
+static void btr_search_sample(dict_index_t::ahi &info,
+                              Atomic_relaxed<uint32_t> &counter) noexcept
+{
+  counter.fetch_add(1);
+  if (!((info.window_samples.fetch_add(1) + 1) % BTR_SEARCH_ADMISSION_WINDOW))
+    btr_search_admit(info);
+}
+
+/** Account for a modification of a leaf page of an index.
+@param index   index
+@param hashed  whether the page is in the adaptive hash index
+@return whether the adaptive hash index entries for the page should be
+dropped instead of being updated */
+static bool btr_search_note_modification(dict_index_t *index, bool hashed)
+  noexcept
+{
+  dict_index_t::ahi &info= index->search_info;
+  const bool excluded= info.excluded;
+  if (!hashed && !excluded)
+    return false;
+  if (btr_search_sampled())
+  {
+    if (hashed)
+      info.maintenance.add(BTR_SEARCH_SAMPLE_RATE);
+    btr_search_sample(info, info.window_maintenance);
+  }
+  return hashed && excluded;
+}
+
 /** Determine the number of accessed key fields.
 @param n_bytes_fields  number of complete fields | incomplete_bytes << 16
 @return number of complete or incomplete fields */
@@ -690,8 +761,13 @@ static uint32_t btr_search_info_update_hash(const btr_cur_t &cursor) noexcept
     goto no_help;
   }
   else if (uint16_t(left_bytes_fields) >= n_uniq && cursor.up_match >= n_uniq)
+  {
     /* The search would have succeeded using the recommended prefix */
+  potential_hit:
+    if (info.excluded && btr_search_sampled())
+      btr_search_sample(info, info.window_hits);
     goto increment_potential;
+  }
   else
   {
     const bool left_side{!!(left_bytes_fields & buf_block_t::LEFT_SIDE)};
@@ -702,7 +778,7 @@ static uint32_t btr_search_info_update_hash(const btr_cur_t &cursor) noexcept
     const int up_cmp = int(cursor.up_match << 16 | cursor.up_bytes);
 
     if (left_side == (info_cmp > low_cmp) && left_side == (info_cmp <= up_cmp))
-      goto increment_potential;
+      goto potential_hit;
 
     const int cmp= up_cmp - low_cmp;
     static_assert(buf_block_t::LEFT_SIDE == 1U << 31, "");
@@ -795,7 +871,8 @@ static uint32_t btr_search_info_update_hash(const btr_cur_t &cursor) noexcept
   else if (cursor.flag == BTR_CUR_HASH_FAIL)
     btr_search_update_hash_ref(cursor, block, left_bytes_fields);
 
-  return ret;
+  /* Do not build the hash index for pages of an excluded index. */
+  return info.excluded ? 0 : ret;
 }
 
 inline ahi_node *btr_sea::partition::cleanup_after_erase_start() noexcept
@@ -1112,7 +1189,8 @@ btr_search_guess_on_hash(
     return false;
 
   if (!index->search_info.last_hash_succ ||
-      !index->search_info.n_hash_potential)
+      !index->search_info.n_hash_potential ||
+      index->search_info.excluded)
   {
   ahi_unusable:
     if (!index->table->is_temporary() && btr_search.enabled)
@@ -1262,6 +1340,11 @@ btr_search_guess_on_hash(
     index->search_info.n_hash_potential= n_hash_potential;
 
   index->search_info.last_hash_succ= true;
+  if (btr_search_sampled())
+  {
+    index->search_info.hits.add(BTR_SEARCH_SAMPLE_RATE);
+    btr_search_sample(index->search_info, index->search_info.window_hits);
+  }
   cursor->flag= BTR_CUR_HASH;
 
 #ifdef UNIV_SEARCH_PERF_STAT
@@ -1784,10 +1867,14 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor) noexcept
   assert_block_ahi_valid(block);
   dict_index_t *index= block->index;
   if (!index)
+  {
+    btr_search_note_modification(cursor->index(), false);
     return;
+  }
   ut_ad(!cursor->index()->table->is_temporary());
 
-  if (UNIV_UNLIKELY(index != cursor->index()))
+  if (UNIV_UNLIKELY(index != cursor->index()) ||
+      btr_search_note_modification(index, true))
   {
     btr_search_drop_page_hash_index(block, nullptr);
     return;
@@ -1858,12 +1945,16 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor, bool reorg) noexcept
   dict_index_t *index= block->index;
 
   if (!index)
+  {
+    btr_search_note_modification(cursor->index(), false);
     return;
+  }
 
   ut_ad(block->page.id().space() == index->table->space_id);
   const rec_t *rec= btr_cur_get_rec(cursor);
 
-  if (UNIV_UNLIKELY(index != cursor->index()))
+  if (UNIV_UNLIKELY(index != cursor->index()) ||
+      btr_search_note_modification(index, true))
   {
     ut_ad(index->id == cursor->index()->id);
   drop:
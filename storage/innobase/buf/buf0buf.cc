@@ -42,6 +42,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0rea.h"
 #include "buf0flu.h"
 #include "buf0buddy.h"
+#include "buf0ccache.h"
 #include "buf0dblwr.h"
 #include "lock0lock.h"
 #include "btr0sea.h"
@@ -1265,6 +1266,10 @@ buf_block_t *buf_pool_t::allocate() noexcept
 
   while (buf_page_t *b= UT_LIST_GET_FIRST(free))
   {
+#ifdef HAVE_LIBNUMA
+    if (UNIV_UNLIKELY(numa_n_nodes != 0))
+      b= numa_local_free(b);
+#endif
     ut_ad(b->in_free_list);
     ut_d(b->in_free_list = FALSE);
     ut_ad(!b->oldest_modification());
@@ -1430,7 +1435,12 @@ bool buf_pool_t::create() noexcept
                         " buffer pool page frames to MPOL_INTERLEAVE"
                         " (error: %s).", strerror(errno));
     numa_bitmask_free(numa_mems_allowed);
+    if (srv_numa_node_local)
+      sql_print_warning("InnoDB: innodb_numa_node_local is ignored"
+                        " because innodb_numa_interleave is set");
   }
+  else if (srv_numa_node_local)
+    numa_create();
 #endif /* HAVE_LIBNUMA */
 
   n_blocks= get_n_blocks(actual_size);
@@ -1459,6 +1469,11 @@ bool buf_pool_t::create() noexcept
     }
   }
 
+#ifdef HAVE_LIBNUMA
+  if (numa_n_nodes)
+    numa_interleave_free();
+#endif
+
 #if defined(__aarch64__)
   mysql_mutex_init(buf_pool_mutex_key, &mutex, MY_MUTEX_INIT_FAST);
 #else
@@ -1604,8 +1619,153 @@ void buf_pool_t::close() noexcept
   io_buf.close();
   aligned_free(const_cast<byte*>(field_ref_zero));
   field_ref_zero= nullptr;
+#ifdef HAVE_LIBNUMA
+  ut_free(numa_cpu_node);
+  numa_cpu_node= nullptr;
+  numa_n_nodes= 0;
+#endif
 }
 
+#ifdef HAVE_LIBNUMA
+void buf_pool_t::numa_create() noexcept
+{
+  if (numa_available() < 0)
+  {
+    sql_print_warning("InnoDB: innodb_numa_node_local is ignored"
+                      " because NUMA is not available");
+    return;
+  }
+
+  struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
+  MEM_MAKE_DEFINED(numa_mems_allowed, sizeof *numa_mems_allowed);
+  uint n= 0;
+  for (int node= 0; node <= numa_max_node() && n < NUMA_MAX_NODES; node++)
+    if (numa_bitmask_isbitset(numa_mems_allowed, node))
+      numa_nodes[n++]= node;
+  numa_bitmask_free(numa_mems_allowed);
+  if (n < 2)
+    return;
+
+  /* Prefer the node of each extent, so that the allocation does not
+  fail if a node runs out of memory. Also the extents beyond the
+  current innodb_buffer_pool_size are covered, for resize(). */
+  struct bitmask *mask= numa_allocate_nodemask();
+  const char *const end= memory_unaligned + size_unaligned;
+  uint i= 0;
+  for (char *extent= memory; extent < end;
+       extent+= innodb_buffer_pool_extent_size, i++)
+  {
+    numa_bitmask_clearall(mask);
+    numa_bitmask_setbit(mask, numa_nodes[i % n]);
+    if (mbind(extent,
+              std::min<size_t>(innodb_buffer_pool_extent_size, end - extent),
+              MPOL_PREFERRED, mask->maskp, mask->size, MPOL_MF_MOVE))
+    {
+      sql_print_warning("InnoDB: Failed to set NUMA memory policy of"
+                        " buffer pool page frames to MPOL_PREFERRED"
+                        " (error: %s).", strerror(errno));
+      numa_bitmask_free(mask);
+      return;
+    }
+  }
+  numa_bitmask_free(mask);
+
+  const int n_cpus= numa_num_configured_cpus();
+  if (n_cpus <= 0 ||
+      !(numa_cpu_node= static_cast<byte*>(ut_zalloc_nokey(n_cpus))))
+    return;
+  numa_n_cpus= n_cpus;
+  for (uint cpu= 0; cpu < numa_n_cpus; cpu++)
+  {
+    const int node= numa_node_of_cpu(cpu);
+    for (uint j= 0; j < n; j++)
+      if (numa_nodes[j] == node)
+        numa_cpu_node[cpu]= byte(j);
+  }
+
+  for (numa_stat_t &stat : numa_stat)
+  {
+    stat.n_pages_read= 0;
+    stat.old_n_page_gets= 0;
+    stat.old_n_pages_read= 0;
+  }
+
+  numa_n_nodes= n;
+  sql_print_information("InnoDB: Distributing the buffer pool over"
+                        " %u NUMA nodes", n);
+}
+
+void buf_pool_t::numa_interleave_free() noexcept
+{
+  UT_LIST_BASE_NODE_T(buf_page_t) node_free[NUMA_MAX_NODES];
+  for (uint i= 0; i < numa_n_nodes; i++)
+    UT_LIST_INIT(node_free[i], &buf_page_t::list);
+
+  while (buf_page_t *b= UT_LIST_GET_FIRST(free))
+  {
+    UT_LIST_REMOVE(free, b);
+    UT_LIST_ADD_LAST(node_free[numa_node(b)], b);
+  }
+
+  for (bool added= true; added; )
+  {
+    added= false;
+    for (uint i= 0; i < numa_n_nodes; i++)
+    {
+      if (buf_page_t *b= UT_LIST_GET_FIRST(node_free[i]))
+      {
+        UT_LIST_REMOVE(node_free[i], b);
+        UT_LIST_ADD_LAST(free, b);
+        added= true;
+      }
+    }
+  }
+}
+
+buf_page_t *buf_pool_t::numa_local_free(buf_page_t *first) const noexcept
+{
+  /* After numa_interleave_free(), and with blocks being freed from the
+  LRU list in any order, a block of any node is likely to be found
+  among the first few ones. The block descriptor resides in the same
+  extent as its page frame. */
+  const uint node= numa_current_node();
+  uint n= 4 * numa_n_nodes;
+  for (buf_page_t *b= first; b && n--; b= UT_LIST_GET_NEXT(list, b))
+    if (numa_node(b) == node)
+      return b;
+  return first;
+}
+
+uint buf_pool_t::numa_current_node() const noexcept
+{
+  const int cpu= sched_getcpu();
+  return cpu >= 0 && uint(cpu) < numa_n_cpus ? numa_cpu_node[cpu] : 0;
+}
+
+size_t buf_pool_t::numa_curr_size(uint node) const noexcept
+{
+  ut_ad(node < numa_n_nodes);
+  const size_t per_extent=
+    pages_in_extent[srv_page_size_shift - UNIV_PAGE_SIZE_SHIFT_MIN];
+  const size_t extents= n_blocks / per_extent, rest= n_blocks % per_extent;
+  size_t size= (extents / numa_n_nodes + (node < extents % numa_n_nodes)) *
+    per_extent;
+  if (extents % numa_n_nodes == node)
+    size+= rest;
+  return size;
+}
+
+void buf_pool_t::numa_page_get(const buf_page_t &bpage) noexcept
+{
+  if (!bpage.frame)
+    return;
+  const uint node= numa_current_node();
+  numa_stat[node].n_page_gets.inc();
+  if (numa_node(bpage.frame) != node)
+    numa_stat[node].n_page_gets_remote.inc();
+}
+#endif /* HAVE_LIBNUMA */
+
 void buf_pool_t::io_buf_t::create(ulint n_slots) noexcept
 {
   this->n_slots= n_slots;
@@ -2934,6 +3094,12 @@ buf_page_get_gen(
 	if (!(++buf_dbg_counter % 5771)) buf_pool.validate();
 #endif /* UNIV_DEBUG */
 
+#ifdef HAVE_LIBNUMA
+	if (UNIV_UNLIKELY(buf_pool.numa_n_nodes != 0)) {
+		buf_pool.numa_page_get(block->page);
+	}
+#endif
+
 	/* The state = block->page.state() may be stale at this point,
 	and in fact, at any point of time if we consider its
 	buffer-fix component. If the block is being read into the
@@ -3330,6 +3496,10 @@ static buf_block_t *buf_page_create_low(page_id_t page_id, ulint zip_size,
   buf_pool.stat.n_pages_created++;
   mysql_mutex_unlock(&buf_pool.mutex);
 
+  if (buf_ccache.n_pages)
+    /* Any previous contents of the page are garbage. */
+    buf_ccache.invalidate(page_id);
+
   mtr->memo_push(reinterpret_cast<buf_block_t*>(bpage), MTR_MEMO_PAGE_X_FIX);
 
   bpage->set_accessed();
@@ -3800,6 +3970,13 @@ void buf_refresh_io_stats() noexcept
 {
 	buf_pool.last_printout_time = time(NULL);
 	buf_pool.old_stat = buf_pool.stat;
+#ifdef HAVE_LIBNUMA
+	for (uint i = 0; i < buf_pool.numa_n_nodes; i++) {
+		buf_pool_t::numa_stat_t& stat = buf_pool.numa_stat[i];
+		stat.old_n_page_gets = stat.n_page_gets;
+		stat.old_n_pages_read = stat.n_pages_read;
+	}
+#endif
 }
 
 /** Invalidate all pages in the buffer pool.
@@ -0,0 +1,288 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file buf/buf0ccache.cc
+Compressed cache of pages that were evicted from the buffer pool
+*******************************************************/
+
+#include "buf0ccache.h"
+#include "buf0buf.h"
+#include "fil0fil.h"
+#include "log0recv.h"
+#include "mach0data.h"
+#include "zlib.h"
+#include "lz4.h"
+
+/** The compressed page cache */
+buf_ccache_t buf_ccache;
+
+void buf_ccache_t::create() noexcept
+{
+  ut_ad(!m_initialised);
+  for (shard &s : shards)
+  {
+    s.mutex.init();
+    UT_LIST_INIT(s.LRU, &entry::LRU);
+    s.bytes= 0;
+    s.last_ticket= 0;
+  }
+  m_initialised= true;
+}
+
+void buf_ccache_t::close() noexcept
+{
+  if (!m_initialised)
+    return;
+  resize(0);
+  for (shard &s : shards)
+  {
+    ut_ad(!UT_LIST_GET_LEN(s.LRU));
+    ut_ad(s.pages.empty());
+    s.mutex.destroy();
+  }
+  m_initialised= false;
+}
+
+void buf_ccache_t::remove_low(shard &s, entry *e) noexcept
+{
+  UT_LIST_REMOVE(s.LRU, e);
+  s.bytes-= e->len;
+  n_bytes-= e->len;
+  n_pages--;
+}
+
+void buf_ccache_t::shrink_low(shard &s, size_t limit) noexcept
+{
+  while (s.bytes > limit)
+  {
+    entry *e= UT_LIST_GET_LAST(s.LRU);
+    remove_low(s, e);
+    s.pages.erase(e->id);
+    ut_free(e);
+  }
+}
+
+void buf_ccache_t::resize(size_t size) noexcept
+{
+  max_size= size;
+  if (!m_initialised)
+    return;
+  for (shard &s : shards)
+  {
+    s.mutex.wr_lock();
+    shrink_low(s, size / N_SHARDS);
+    if (!size)
+      /* Discard any reservations as well. */
+      s.pages.clear();
+    s.mutex.wr_unlock();
+  }
+}
+
+size_t buf_ccache_t::reserve(const buf_page_t &bpage) noexcept
+{
+  mysql_mutex_assert_owner(&buf_pool.mutex);
+  ut_ad(!bpage.oldest_modification());
+
+  const page_id_t id{bpage.id()};
+  if (!enabled() || id.space() >= SRV_TMP_SPACE_ID || bpage.zip.data ||
+      bpage.is_freed() || recv_recovery_is_on())
+    return 0;
+
+  shard &s= get_shard(id);
+  s.mutex.wr_lock();
+  const size_t ticket= ++s.last_ticket;
+  slot &sl= s.pages[id];
+  if (entry *e= sl.page)
+  {
+    /* A copy that was added while the cache was disabled is obsolete. */
+    remove_low(s, e);
+    ut_free(e);
+  }
+  sl.page= nullptr;
+  sl.ticket= ticket;
+  s.mutex.wr_unlock();
+  return ticket;
+}
+
+buf_ccache_t::entry *buf_ccache_t::compress(const page_id_t id,
+                                            const byte *frame) noexcept
+{
+  const bool lz4= provider_service_lz4->is_loaded;
+  const size_t bound= lz4
+    ? size_t(LZ4_compressBound(int(srv_page_size)))
+    : size_t(compressBound(uLong(srv_page_size)));
+  entry *e= static_cast<entry*>(ut_malloc_nokey(sizeof *e + bound));
+  if (!e)
+    return nullptr;
+
+  size_t len= 0;
+  if (lz4)
+    len= size_t(std::max(0, LZ4_compress_default
+                         (reinterpret_cast<const char*>(frame),
+                          reinterpret_cast<char*>(e->data()),
+                          int(srv_page_size), int(bound))));
+  else
+  {
+    uLong zlen= uLong(bound);
+    if (compress2(e->data(), &zlen, frame, uLong(srv_page_size),
+                  Z_BEST_SPEED) == Z_OK)
+      len= size_t(zlen);
+  }
+
+  /* Only keep pages that compress to at most 7/8 of the page size. */
+  if (!len || len > srv_page_size - (srv_page_size >> 3))
+  {
+    ut_free(e);
+    return nullptr;
+  }
+
+  if (entry *shrunk= static_cast<entry*>(ut_realloc(e, sizeof *e + len)))
+    e= shrunk;
+  new (e) entry(id);
+  e->len= uint32_t(len);
+  e->lz4= lz4;
+  return e;
+}
+
+void buf_ccache_t::add(const page_id_t id, size_t ticket, byte *frame)
+  noexcept
+{
+  /* Do not cache pages of a tablespace that is being dropped.
+  fil_space_t::drop() will wait for our reference to be released
+  before remove_space() is invoked. */
+  fil_space_t *space= fil_space_t::get(id.space());
+
+  entry *e= nullptr;
+  if (space)
+  {
+    mach_write_to_4(frame + FIL_PAGE_OFFSET, id.page_no());
+    mach_write_to_4(frame + FIL_PAGE_SPACE_ID, id.space());
+    e= compress(id, frame);
+  }
+
+  shard &s= get_shard(id);
+  s.mutex.wr_lock();
+  auto i= s.pages.find(id);
+  if (i == s.pages.end() || i->second.ticket != ticket)
+    /* The page was read back, or the cache was disabled. */;
+  else if (!e || !enabled())
+    s.pages.erase(i);
+  else
+  {
+    ut_ad(!i->second.page);
+    i->second.page= e;
+    UT_LIST_ADD_FIRST(s.LRU, e);
+    s.bytes+= e->len;
+    n_bytes+= e->len;
+    n_pages++;
+    shrink_low(s, max_size / N_SHARDS);
+    e= nullptr;
+  }
+  s.mutex.wr_unlock();
+
+  ut_free(e);
+  if (space)
+    space->release();
+}
+
+bool buf_ccache_t::get(const page_id_t id, byte *frame) noexcept
+{
+  shard &s= get_shard(id);
+  entry *e= nullptr;
+  s.mutex.wr_lock();
+  auto i= s.pages.find(id);
+  if (i != s.pages.end())
+  {
+    /* Consume the copy, or cancel a pending add(). */
+    if ((e= i->second.page))
+      remove_low(s, e);
+    s.pages.erase(i);
+  }
+  s.mutex.wr_unlock();
+
+  bool ok= false;
+  if (!e);
+  else if (e->lz4)
+    ok= provider_service_lz4->is_loaded &&
+      LZ4_decompress_safe(reinterpret_cast<const char*>(e->data()),
+                          reinterpret_cast<char*>(frame),
+                          int(e->len), int(srv_page_size)) ==
+      int(srv_page_size);
+  else
+  {
+    uLongf len= uLongf(srv_page_size);
+    ok= uncompress(frame, &len, e->data(), uLong(e->len)) == Z_OK &&
+      len == srv_page_size;
+  }
+
+  ut_free(e);
+
+  if (ok && mach_read_from_4(frame + FIL_PAGE_OFFSET) == id.page_no() &&
+      mach_read_from_4(frame + FIL_PAGE_SPACE_ID) == id.space())
+  {
+    hits++;
+    return true;
+  }
+
+  misses++;
+  return false;
+}
+
+void buf_ccache_t::invalidate(const page_id_t id) noexcept
+{
+  shard &s= get_shard(id);
+  s.mutex.wr_lock();
+  auto i= s.pages.find(id);
+  entry *e= nullptr;
+  if (i != s.pages.end())
+  {
+    if ((e= i->second.page))
+      remove_low(s, e);
+    s.pages.erase(i);
+  }
+  s.mutex.wr_unlock();
+  ut_free(e);
+}
+
+void buf_ccache_t::remove_space(uint32_t space_id) noexcept
+{
+  /* Any reservation is resolved by add() while it holds a reference
+  to the tablespace, which fil_space_t::drop() waits for. */
+  if (!m_initialised || !n_pages)
+    return;
+  for (shard &s : shards)
+  {
+    s.mutex.wr_lock();
+    for (auto i= s.pages.begin(); i != s.pages.end(); )
+    {
+      if (i->first.space() != space_id)
+      {
+        ++i;
+        continue;
+      }
+      if (entry *e= i->second.page)
+      {
+        remove_low(s, e);
+        ut_free(e);
+      }
+      i= s.pages.erase(i);
+    }
+    s.mutex.wr_unlock();
+  }
+}
@@ -40,6 +40,15 @@ using st_::span;
 /** The doublewrite buffer */
 buf_dblwr_t buf_dblwr;
 
+/** @return the number of pages in a write batch */
+inline ulint buf_dblwr_t::batch_size() const noexcept
+{
+  /* With innodb_doublewrite_pipeline, each slot is written to its own
+  block, so that the next batch can be written to the doublewrite buffer
+  while the data pages of the previous batch are being written. */
+  return srv_doublewrite_pipeline ? block_size : 2 * block_size;
+}
+
 /** @return the TRX_SYS page */
 inline buf_block_t *buf_dblwr_trx_sys_get(mtr_t *mtr) noexcept
 {
@@ -64,7 +73,7 @@ inline void buf_dblwr_t::init(const byte *header) noexcept
 {
   ut_ad(!active_slot->first_free);
   ut_ad(!active_slot->reserved);
-  ut_ad(!batch_running);
+  ut_ad(!batch_running());
 
   block1= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK1));
   block2= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK2));
@@ -460,7 +469,7 @@ void buf_dblwr_t::close() noexcept
 
   ut_ad(!active_slot->reserved);
   ut_ad(!active_slot->first_free);
-  ut_ad(!batch_running);
+  ut_ad(!batch_running());
 
   pthread_cond_destroy(&cond);
   for (int i= 0; i < 2; i++)
@@ -482,8 +491,9 @@ void buf_dblwr_t::write_completed() noexcept
   mysql_mutex_lock(&mutex);
 
   ut_ad(is_created());
-  ut_ad(batch_running);
-  slot *flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  /* Only one slot at a time can be in the BATCH_PAGES state. */
+  slot *flush_slot= slots[0].state == BATCH_PAGES ? &slots[0] : &slots[1];
+  ut_ad(flush_slot->state == BATCH_PAGES);
   ut_ad(flush_slot->reserved);
   ut_ad(flush_slot->reserved <= flush_slot->first_free);
 
@@ -496,8 +506,18 @@ void buf_dblwr_t::write_completed() noexcept
 
     /* We can now reuse the doublewrite memory buffer: */
     flush_slot->first_free= 0;
-    batch_running= false;
+    flush_slot->state= BATCH_IDLE;
+    /* With innodb_doublewrite_pipeline, the other batch may be waiting
+    for us to write its data pages. */
+    slot *next= other(flush_slot);
+    const bool ready= next->state == BATCH_READY;
+    if (ready)
+      next->state= BATCH_PAGES;
     pthread_cond_broadcast(&cond);
+    mysql_mutex_unlock(&mutex);
+    if (ready)
+      write_pages(*next);
+    return;
   }
 
   mysql_mutex_unlock(&mutex);
@@ -570,16 +590,19 @@ ATTRIBUTE_COLD void buf_dblwr_t::print_info() const noexcept
 {
   mysql_mutex_assert_owner(&mutex);
   const slot *flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  static const char *const states[]= {"idle", "doublewrite", "ready", "pages"};
 
   sql_print_information("InnoDB: Double Write State\n"
       "-------------------\n"
       "Batch running : %s\n"
-      "Active Slot - first_free: %zu reserved:  %zu\n"
-      "Flush Slot  - first_free: %zu reserved:  %zu\n"
+      "Active Slot - first_free: %zu reserved:  %zu state: %s\n"
+      "Flush Slot  - first_free: %zu reserved:  %zu state: %s\n"
       "-------------------",
-      (batch_running ? "true" : "false"),
+      (batch_running() ? "true" : "false"),
       active_slot->first_free, active_slot->reserved,
-      flush_slot->first_free, flush_slot->reserved);
+      states[active_slot->state],
+      flush_slot->first_free, flush_slot->reserved,
+      states[flush_slot->state]);
 }
 
 bool buf_dblwr_t::flush_buffered_writes(const ulint size) noexcept
@@ -595,9 +618,17 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size) noexcept
 
   for (size_t count= 0;;)
   {
-    if (!active_slot->first_free)
+    /* If the active slot is still in use by a previous batch, then
+    nothing has been buffered in it. */
+    if (active_slot->state != BATCH_IDLE || !active_slot->first_free)
       return false;
-    if (!batch_running)
+    const batch_state s= other(active_slot)->state;
+    /* Normally, the batches use the whole doublewrite buffer and must be
+    written one at a time. With innodb_doublewrite_pipeline, we may write
+    to our block of the doublewrite buffer while the data pages of the
+    other batch are being written. */
+    ut_ad(s != BATCH_READY);
+    if (s == BATCH_IDLE || (s == BATCH_PAGES && srv_doublewrite_pipeline))
       break;
 
     timespec abstime;
@@ -632,14 +663,15 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size) noexcept
 
   /* Disallow anyone else to start another batch of flushing. */
   slot *flush_slot= active_slot;
-  /* Switch the active slot */
-  active_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
-  ut_a(active_slot->first_free == 0);
-  batch_running= true;
+  /* Switch the active slot. With innodb_doublewrite_pipeline, the
+  other slot may still be in use; add_to_batch() will wait for it. */
+  active_slot= other(active_slot);
+  ut_a(active_slot->state != BATCH_IDLE || !active_slot->first_free);
+  flush_slot->state= BATCH_DBLWR;
   const ulint old_first_free= flush_slot->first_free;
   auto write_buf= flush_slot->write_buf;
-  const bool multi_batch= block1 + static_cast<uint32_t>(size) != block2 &&
-    old_first_free > size;
+  const bool multi_batch= !srv_doublewrite_pipeline &&
+    block1 + static_cast<uint32_t>(size) != block2 && old_first_free > size;
   flushing_buffered_writes= 1 + multi_batch;
   /* Now safe to release the mutex. */
   mysql_mutex_unlock(&mutex);
@@ -661,7 +693,12 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size) noexcept
   const IORequest request{nullptr, nullptr, fil_system.sys_space->chain.start,
                           IORequest::DBLWR_BATCH};
   ut_a(fil_system.sys_space->acquire());
-  if (multi_batch)
+  if (srv_doublewrite_pipeline)
+    os_aio(request, write_buf,
+           os_offset_t{(flush_slot == &slots[0] ? block1 : block2).page_no()}
+           << srv_page_size_shift,
+           old_first_free << srv_page_size_shift);
+  else if (multi_batch)
   {
     fil_system.sys_space->reacquire();
     os_aio(request, write_buf,
@@ -696,7 +733,6 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   ut_ad(request.node == fil_system.sys_space->chain.start);
   ut_ad(request.type == IORequest::DBLWR_BATCH);
   mysql_mutex_lock(&mutex);
-  ut_ad(batch_running);
   ut_ad(flushing_buffered_writes);
   ut_ad(flushing_buffered_writes <= 2);
   writes_completed++;
@@ -706,7 +742,10 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
     return;
   }
 
-  slot *const flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  /* Only one slot at a time can be in the BATCH_DBLWR state. */
+  slot *const flush_slot= slots[0].state == BATCH_DBLWR
+    ? &slots[0] : &slots[1];
+  ut_ad(flush_slot->state == BATCH_DBLWR);
   ut_ad(flush_slot->reserved == flush_slot->first_free);
   /* increment the doublewrite flushed pages counter */
   pages_written+= flush_slot->first_free;
@@ -722,10 +761,26 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   os_file_flush(request.node->handle);
 
   /* The writes have been flushed to disk now and in recovery we will
-  find them in the doublewrite buffer blocks. Next, write the data pages. */
-  for (ulint i= 0, first_free= flush_slot->first_free; i < first_free; i++)
+  find them in the doublewrite buffer blocks. Next, write the data pages,
+  unless the data pages of the other batch are still being written. */
+  mysql_mutex_lock(&mutex);
+  const batch_state s= other(flush_slot)->state;
+  ut_ad(s == BATCH_IDLE || (s == BATCH_PAGES && srv_doublewrite_pipeline));
+  flush_slot->state= s == BATCH_PAGES ? BATCH_READY : BATCH_PAGES;
+  /* Another batch may be written to the doublewrite buffer now. */
+  pthread_cond_broadcast(&cond);
+  mysql_mutex_unlock(&mutex);
+
+  if (s != BATCH_PAGES)
+    write_pages(*flush_slot);
+}
+
+void buf_dblwr_t::write_pages(const slot &s) noexcept
+{
+  ut_ad(s.state == BATCH_PAGES);
+  for (ulint i= 0, first_free= s.first_free; i < first_free; i++)
   {
-    auto e= flush_slot->buf_block_arr[i];
+    auto e= s.buf_block_arr[i];
     buf_page_t* bpage= e.request.bpage;
     ut_ad(bpage->in_file());
 
@@ -804,17 +859,19 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size) noexcept
   ut_ad(request.node->space->referenced());
   ut_ad(!srv_read_only_mode);
 
-  const ulint buf_size= 2 * block_size;
+  const ulint buf_size= batch_size();
 
   mysql_mutex_lock(&mutex);
 
   for (;;)
   {
     ut_ad(active_slot->first_free <= buf_size);
-    if (active_slot->first_free != buf_size)
+    if (active_slot->state != BATCH_IDLE)
+      /* Wait for the previous batch of this slot to complete. */
+      my_cond_wait(&cond, &mutex.m_mutex);
+    else if (active_slot->first_free != buf_size)
       break;
-
-    if (flush_buffered_writes(buf_size / 2))
+    else if (flush_buffered_writes(block_size))
       mysql_mutex_lock(&mutex);
   }
 
@@ -837,6 +894,6 @@ void buf_dblwr_t::add_to_batch(const IORequest &request, size_t size) noexcept
   active_slot->reserved= active_slot->first_free;
 
   if (active_slot->first_free != buf_size ||
-      !flush_buffered_writes(buf_size / 2))
+      !flush_buffered_writes(block_size))
     mysql_mutex_unlock(&mutex);
 }
@@ -28,6 +28,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "fil0fil.h"
 #include "btr0btr.h"
 #include "buf0buddy.h"
+#include "buf0ccache.h"
 #include "buf0buf.h"
 #include "buf0flu.h"
 #include "buf0rea.h"
@@ -820,6 +821,11 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 
 	ut_ad(bpage->can_relocate());
 
+	/* A copy of the page may be kept in buf_ccache. This must be
+	decided while the page is still in buf_pool.page_hash, so that
+	a subsequent read of the page will cancel the add(). */
+	const size_t ccache_ticket = b ? 0 : buf_ccache.reserve(*bpage);
+
 	if (!buf_LRU_block_remove_hashed(bpage, id, chain, zip)) {
 		ut_ad(!b);
 		mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
@@ -935,6 +941,15 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 		ut_ad(b->zip_size());
 		b->lock.x_unlock();
 		b->unfix();
+	} else if (ccache_ticket) {
+		/* The block is not in buf_pool.page_hash or buf_pool.free,
+		and its contents are still valid, except for the fields
+		that buf_LRU_block_remove_hashed() overwrote. */
+		mysql_mutex_unlock(&buf_pool.mutex);
+		MEM_MAKE_DEFINED(block->page.frame, srv_page_size);
+		buf_ccache.add(id, ccache_ticket, block->page.frame);
+		MEM_UNDEFINED(block->page.frame, srv_page_size);
+		mysql_mutex_lock(&buf_pool.mutex);
 	}
 
 	buf_LRU_block_free_hashed_page(block);
@@ -34,6 +34,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0flu.h"
 #include "buf0lru.h"
 #include "buf0buddy.h"
+#include "buf0ccache.h"
 #include "buf0dblwr.h"
 #include "page0zip.h"
 #include "log0recv.h"
@@ -189,6 +190,10 @@ static buf_page_t *buf_page_init_for_read(const page_id_t page_id,
   }
 
   buf_pool.stat.n_pages_read++;
+#ifdef HAVE_LIBNUMA
+  if (UNIV_UNLIKELY(buf_pool.numa_n_nodes != 0) && bpage && bpage->frame)
+    buf_pool.numa_stat[buf_pool.numa_node(bpage->frame)].n_pages_read++;
+#endif
   ut_ad(!bpage || bpage->in_file());
   mysql_mutex_unlock(&buf_pool.mutex);
   return bpage;
@@ -318,6 +323,22 @@ buf_read_page_low(
 
   ut_ad(bpage->in_file());
 
+  if (!zip_size && buf_ccache.enabled() &&
+      buf_ccache.get(page_id, bpage->frame))
+  {
+    /* The page was evicted in a clean state, and it had already been
+    validated and decrypted by buf_page_t::read_complete(). */
+    bpage->read_complete_cached();
+    space->release();
+    if (err)
+    {
+      *err= DB_SUCCESS;
+      return bpage;
+    }
+    bpage->unfix();
+    return reinterpret_cast<buf_page_t*>(-1);
+  }
+
   void* dst= zip_size > 1 ? bpage->zip.data : bpage->frame;
   const size_t len= zip_size & ~1 ? zip_size & ~1 : srv_page_size;
 
@@ -775,6 +796,63 @@ ulint buf_read_ahead_linear(const page_id_t page_id) noexcept
   return buf_read_release_count(block, count);
 }
 
+/** Read ahead the leaf pages that an index scan is about to access.
+The pages do not need to be adjacent; see btr_pcur_move_to_next_page().
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param space_id  tablespace identifier
+@param pages     page numbers
+@param n         number of pages
+@return number of page read requests issued */
+ulint buf_read_ahead_scan(uint32_t space_id, const uint32_t *pages, size_t n)
+  noexcept
+{
+  if (space_id >= SRV_TMP_SPACE_ID || srv_startup_is_before_trx_rollback_phase)
+    return 0;
+
+  if (os_aio_pending_reads_approx() >
+      buf_pool.curr_size() / BUF_READ_AHEAD_PEND_LIMIT)
+    return 0;
+
+  fil_space_t *space= fil_space_t::get(space_id);
+  if (!space)
+    return 0;
+
+  buf_block_t *block= nullptr;
+  unsigned zip_size{space->zip_size()};
+  if (UNIV_LIKELY(!zip_size) && UNIV_UNLIKELY(!(block= buf_read_acquire())))
+  {
+    space->release();
+    return 0;
+  }
+
+  ulint count= 0;
+  const uint32_t last= space->last_page_number();
+  for (size_t i= 0; i < n; i++)
+  {
+    if (space->is_stopping())
+      break;
+    if (pages[i] > last)
+      continue;
+    const page_id_t id{space_id, pages[i]};
+    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id.fold());
+    space->reacquire();
+    if (reinterpret_cast<buf_page_t*>(-1) ==
+        buf_read_page_low(id, zip_size, nullptr, chain, space, block, nullptr))
+    {
+      count++;
+      ut_ad(!block);
+      if (UNIV_LIKELY(!zip_size) && UNIV_UNLIKELY(!(block= buf_read_acquire())))
+        break;
+    }
+  }
+
+  space->release();
+  buf_pool.scan_read_ahead+= count;
+  return buf_read_release_count(block, count);
+}
+
 /** Schedule a page for recovery.
 @param space    tablespace
 @param page_id  page identifier
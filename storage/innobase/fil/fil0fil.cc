@@ -29,6 +29,7 @@ Created 10/25/1995 Heikki Tuuri
 
 #include "btr0btr.h"
 #include "buf0buf.h"
+#include "buf0ccache.h"
 #include "dict0boot.h"
 #include "dict0dict.h"
 #include "dict0load.h"
@@ -903,6 +904,7 @@ static void fil_space_free_low(fil_space_t *space) noexcept
 
 	ut_ad(space->size == 0);
 
+	buf_ccache.remove_space(space->id);
 	fil_space_destroy_crypt_data(&space->crypt_data);
 
 	space->~fil_space_t();
@@ -70,6 +70,7 @@ bool is_update_query(enum enum_sql_command command);
 #include "btr0cur.h"
 #include "btr0bulk.h"
 #include "btr0sea.h"
+#include "buf0ccache.h"
 #include "buf0dblwr.h"
 #include "buf0dump.h"
 #include "buf0buf.h"
@@ -887,6 +888,10 @@ static MYSQL_THDVAR_UINT(lock_wait_timeout, PLUGIN_VAR_RQCMDARG,
   "Timeout in seconds an InnoDB transaction may wait for a lock before being rolled back. The value 100000000 is infinite timeout",
   NULL, NULL, 50, 0, 100000000, 0);
 
+static MYSQL_THDVAR_UINT(parallel_scan_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that scan the clustered index to count the rows of a table for COUNT(*) without a WHERE clause. 1 disables the parallel scan",
+  NULL, NULL, 1, 1, 256, 0);
+
 static MYSQL_THDVAR_STR(ft_user_stopword_table,
   PLUGIN_VAR_OPCMDARG|PLUGIN_VAR_MEMALLOC,
   "User supplied stopword table name, effective in the session level",
@@ -969,12 +974,21 @@ static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_read_ahead", &buf_pool.stat.n_ra_pages_read, SHOW_SIZE_T},
   {"buffer_pool_read_ahead_evicted",
    &buf_pool.stat.n_ra_pages_evicted, SHOW_SIZE_T},
+  {"buffer_pool_read_ahead_scan", &buf_pool.scan_read_ahead, SHOW_SIZE_T},
+  {"buffer_pool_read_ahead_scan_hits",
+   &buf_pool.scan_read_ahead_hits, SHOW_SIZE_T},
+  {"buffer_pool_read_ahead_scan_misses",
+   &buf_pool.scan_read_ahead_misses, SHOW_SIZE_T},
   {"buffer_pool_read_requests", &buf_pool.stat.n_page_gets, SHOW_SIZE_T},
   {"buffer_pool_reads", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
   {"buffer_pool_wait_free", &buf_pool.stat.LRU_waits, SHOW_SIZE_T},
   {"buffer_pool_write_requests", &buf_pool.flush_list_requests, SHOW_SIZE_T},
   {"checkpoint_age", &export_vars.innodb_checkpoint_age, SHOW_SIZE_T},
   {"checkpoint_max_age", &export_vars.innodb_checkpoint_max_age, SHOW_SIZE_T},
+  {"compressed_cache_bytes", &buf_ccache.n_bytes, SHOW_SIZE_T},
+  {"compressed_cache_hits", &buf_ccache.hits, SHOW_SIZE_T},
+  {"compressed_cache_misses", &buf_ccache.misses, SHOW_SIZE_T},
+  {"compressed_cache_pages", &buf_ccache.n_pages, SHOW_SIZE_T},
   {"data_fsyncs", (size_t*) &os_n_fsyncs, SHOW_SIZE_T},
   {"data_pending_fsyncs",
    (size_t*) &fil_n_pending_tablespace_flushes, SHOW_SIZE_T},
@@ -1080,6 +1094,11 @@ static SHOW_VAR innodb_status_variables[]= {
   /* InnoDB bulk operations */
   {"bulk_operations", &export_vars.innodb_bulk_operations, SHOW_SIZE_T},
 
+  /* Parallel scans for COUNT(*) */
+  {"parallel_scans", &export_vars.innodb_parallel_scans, SHOW_SIZE_T},
+  {"parallel_scan_ranges",
+   &export_vars.innodb_parallel_scan_ranges, SHOW_SIZE_T},
+
   {NullS, NullS, SHOW_LONG}
 };
 
@@ -3585,6 +3604,20 @@ static MYSQL_SYSVAR_SIZE_T(buffer_pool_size_max, buf_pool.size_in_bytes_max,
                            size_t(-ssize_t(innodb_buffer_pool_extent_size)),
                            innodb_buffer_pool_extent_size);
 
+static void innodb_compressed_cache_size_update(THD*, st_mysql_sys_var*,
+                                                void*, const void *save)
+  noexcept
+{
+  buf_ccache.resize(*static_cast<const size_t*>(save));
+}
+
+static MYSQL_SYSVAR_SIZE_T(compressed_cache_size, buf_ccache.max_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum size of the cache of compressed copies of clean pages that were"
+  " evicted from the buffer pool (0=disable)",
+  nullptr, innodb_compressed_cache_size_update, 0, 0,
+  size_t(-ssize_t(1U << 20)), 1U << 20);
+
 static MYSQL_SYSVAR_UINT(log_write_ahead_size, log_sys.write_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Redo log write size to avoid read-on-write; must be a power of two",
@@ -4969,6 +5002,13 @@ ha_innobase::table_flags() const
 	/* Need to use tx_isolation here since table flags is (also)
 	called before prebuilt is inited. */
 
+	/* Let COUNT(*) without a WHERE clause be computed by
+	records_for_count(), which scans the clustered index in
+	parallel. */
+	if (THDVAR(thd, parallel_scan_threads) > 1) {
+		flags |= HA_HAS_RECORDS;
+	}
+
 	if (thd_tx_isolation(thd) <= ISO_READ_COMMITTED) {
 		return(flags | HA_CHECK_UNIQUE_AFTER_WRITE);
 	}
@@ -14369,6 +14409,62 @@ ha_innobase::records_in_range(
 	goto cleanup;
 }
 
+/** Count the rows of the table that are visible to the transaction
+with a parallel scan of the clustered index, for COUNT(*) without a
+WHERE clause when innodb_parallel_scan_threads > 1. records() keeps
+returning the estimate in stats.records.
+@return number of rows
+@retval HA_POS_ERROR if the rows must be counted by a table scan */
+ha_rows ha_innobase::records_for_count()
+{
+	DBUG_ENTER("ha_innobase::records_for_count");
+
+	THD*	thd = ha_thd();
+
+	if (THDVAR(thd, parallel_scan_threads) <= 1) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	update_thd(thd);
+
+	dict_table_t*	ib_table = m_prebuilt->table;
+	trx_t*		trx = m_prebuilt->trx;
+
+	/* Locking reads and tables that cannot be read are left to
+	the table scan, which also reports any errors. */
+	if (m_prebuilt->select_lock_type != LOCK_NONE
+	    || !ib_table->space || !ib_table->is_readable()
+	    || !row_merge_is_index_usable(
+		    trx, dict_table_get_first_index(ib_table))) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx_start_if_not_started(trx, false);
+
+	if (trx->isolation_level != TRX_ISO_READ_UNCOMMITTED) {
+		trx->read_view.open(trx);
+	}
+
+	trx->op_info = "counting rows";
+
+	ulint	n_rows;
+	ulint	n_ranges;
+	dberr_t	err = row_count_parallel(
+		m_prebuilt, THDVAR(m_user_thd, parallel_scan_threads),
+		&n_rows, &n_ranges);
+
+	trx->op_info = "";
+
+	if (err != DB_SUCCESS) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	export_vars.innodb_parallel_scans++;
+	export_vars.innodb_parallel_scan_ranges += n_ranges;
+
+	DBUG_RETURN(n_rows);
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -19080,6 +19176,13 @@ static MYSQL_SYSVAR_ENUM(doublewrite, buf_dblwr.use,
   nullptr, innodb_doublewrite_update, true,
   &innodb_doublewrite_typelib);
 
+static MYSQL_SYSVAR_BOOL(doublewrite_pipeline, srv_doublewrite_pipeline,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Whether to use each half of the doublewrite buffer for a separate batch, "
+  "so that the next batch can be written to the doublewrite buffer while "
+  "the data pages of the previous batch are being written",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, srv_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19497,6 +19600,12 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_UINT(ddl_threads, srv_ddl_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of threads that sort and load the non-unique secondary"
+  " indexes of ALTER TABLE concurrently; 1 builds one index at a time",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19546,6 +19655,12 @@ static MYSQL_SYSVAR_UINT(write_io_threads, srv_n_write_io_threads,
   "Number of background write I/O threads in InnoDB",
   NULL, innodb_write_io_threads_update, 4, 2, 64, 0);
 
+static MYSQL_SYSVAR_UINT(log_recovery_threads, srv_log_recovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Maximum number of threads that apply the redo log to pages during"
+  " crash recovery; 0 (the default) uses the number of CPUs",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt. Value 5 can return bogus data, and 6 can permanently corrupt data",
@@ -19727,6 +19842,12 @@ static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Use NUMA interleave memory policy to allocate InnoDB buffer pool",
   NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(numa_node_local, srv_numa_node_local,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Distribute the InnoDB buffer pool over the NUMA nodes and allocate"
+  " pages from the node of the requesting thread",
+  NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
@@ -19755,6 +19876,12 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_UINT(read_ahead_scan_depth, srv_read_ahead_scan_depth,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of leaf pages that an index scan reads ahead by following"
+  " the node pointers of the parent page (0=disable)",
+  NULL, NULL, 32, 0, 256, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -19981,6 +20108,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_size_auto_min),
 #endif
   MYSQL_SYSVAR(buffer_pool_size_max),
+  MYSQL_SYSVAR(compressed_cache_size),
   MYSQL_SYSVAR(buffer_pool_chunk_size),
   MYSQL_SYSVAR(buffer_pool_filename),
   MYSQL_SYSVAR(buffer_pool_dump_now),
@@ -20005,9 +20133,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
   MYSQL_SYSVAR(stats_include_delete_marked),
+  MYSQL_SYSVAR(doublewrite_pipeline),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
+  MYSQL_SYSVAR(log_recovery_threads),
   MYSQL_SYSVAR(write_io_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(flush_log_at_timeout),
@@ -20027,6 +20157,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(deadlock_report),
   MYSQL_SYSVAR(page_size),
+  MYSQL_SYSVAR(parallel_scan_threads),
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_mmap),
 #if defined __linux__ || defined _WIN32
@@ -20075,6 +20206,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20088,9 +20220,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
+  MYSQL_SYSVAR(numa_node_local),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(read_ahead_scan_depth),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(read_only_compressed),
   MYSQL_SYSVAR(instant_alter_column_allowed),
@@ -20199,7 +20333,8 @@ i_s_innodb_sys_foreign,
 i_s_innodb_sys_foreign_cols,
 i_s_innodb_sys_tablespaces,
 i_s_innodb_sys_virtual,
-i_s_innodb_tablespaces_encryption
+i_s_innodb_tablespaces_encryption,
+i_s_innodb_adaptive_hash_indexes
 maria_declare_plugin_end;
 
 /** Adjust some InnoDB startup parameters based on the data directory */
@@ -3361,36 +3361,29 @@ static ST_FIELD_INFO i_s_innodb_buffer_stats_fields_info[]=
 #define IDX_BUF_STATS_UNZIP_CUR		31
   Column("UNCOMPRESS_CURRENT", ULonglong(), NOT_NULL),
 
+#define IDX_BUF_STATS_GET_REMOTE	32
+  Column("NUMBER_PAGES_GET_REMOTE", ULonglong(), NOT_NULL),
+
   CEnd()
 };
 } // namespace Show
 
-/** Fill INFORMATION_SCHEMA.INNODB_BUFFER_POOL_STATS
+/** Store a row of INFORMATION_SCHEMA.INNODB_BUFFER_POOL_STATS
 @param[in,out]	thd	connection
-@param[in,out]	tables	tables to fill
+@param[in,out]	table	table to fill
+@param[in]	pool_id	POOL_ID
+@param[in]	info	statistics
+@param[in]	n_page_gets_remote	NUMBER_PAGES_GET_REMOTE
 @return 0 on success, 1 on failure */
-static int i_s_innodb_stats_fill(THD *thd, TABLE_LIST * tables, Item *)
+static int i_s_innodb_stats_store(THD *thd, TABLE *table, uint pool_id,
+				  const buf_pool_info_t &info,
+				  ulint n_page_gets_remote)
 {
-	TABLE*		table;
-	Field**		fields;
-	buf_pool_info_t	info;
-
-	DBUG_ENTER("i_s_innodb_stats_fill");
-
-	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
-
-	/* Only allow the PROCESS privilege holder to access the stats */
-	if (check_global_access(thd, PROCESS_ACL)) {
-		DBUG_RETURN(0);
-	}
+	Field**		fields = table->field;
 
-	buf_pool.get_info(&info);
-
-	table = tables->table;
-
-	fields = table->field;
+	DBUG_ENTER("i_s_innodb_stats_store");
 
-	OK(fields[IDX_BUF_STATS_POOL_ID]->store(0, true));
+	OK(fields[IDX_BUF_STATS_POOL_ID]->store(pool_id, true));
 
 	OK(fields[IDX_BUF_STATS_POOL_SIZE]->store(info.pool_size, true));
 
@@ -3488,9 +3481,68 @@ static int i_s_innodb_stats_fill(THD *thd, TABLE_LIST * tables, Item *)
 
 	OK(fields[IDX_BUF_STATS_UNZIP_CUR]->store(info.unzip_cur, true));
 
+	OK(fields[IDX_BUF_STATS_GET_REMOTE]->store(n_page_gets_remote, true));
+
 	DBUG_RETURN(schema_table_store_record(thd, table));
 }
 
+/** Fill INFORMATION_SCHEMA.INNODB_BUFFER_POOL_STATS
+@param[in,out]	thd	connection
+@param[in,out]	tables	tables to fill
+@return 0 on success, 1 on failure */
+static int i_s_innodb_stats_fill(THD *thd, TABLE_LIST * tables, Item *)
+{
+	buf_pool_info_t	info;
+
+	DBUG_ENTER("i_s_innodb_stats_fill");
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* Only allow the PROCESS privilege holder to access the stats */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	buf_pool.get_info(&info);
+
+#ifdef HAVE_LIBNUMA
+	/* With innodb_numa_node_local, return one row per NUMA node,
+	with the node number as POOL_ID. The size, the page requests
+	and the page reads are maintained per node. The other
+	statistics are reported in the row of the first node, so that
+	SUM() over all rows returns the totals. */
+	for (uint i = 0; i < buf_pool.numa_n_nodes; i++) {
+		const buf_pool_t::numa_stat_t& stat = buf_pool.numa_stat[i];
+		buf_pool_info_t	node_info;
+
+		if (i) {
+			memset(&node_info, 0, sizeof node_info);
+		} else {
+			node_info = info;
+		}
+
+		node_info.pool_size = buf_pool.numa_curr_size(i);
+		node_info.n_pages_read = stat.n_pages_read;
+		node_info.n_page_gets = stat.n_page_gets;
+		node_info.page_read_delta = stat.n_pages_read
+			- stat.old_n_pages_read;
+		node_info.n_page_get_delta = stat.n_page_gets
+			- stat.old_n_page_gets;
+
+		OK(i_s_innodb_stats_store(thd, tables->table,
+					  uint(buf_pool.numa_nodes[i]),
+					  node_info,
+					  stat.n_page_gets_remote));
+	}
+
+	if (buf_pool.numa_n_nodes) {
+		DBUG_RETURN(0);
+	}
+#endif /* HAVE_LIBNUMA */
+
+	DBUG_RETURN(i_s_innodb_stats_store(thd, tables->table, 0, info, 0));
+}
+
 /*******************************************************************//**
 Bind the dynamic table INFORMATION_SCHEMA.INNODB_BUFFER_POOL_STATS.
 @return 0 on success, 1 on failure */
@@ -6520,3 +6572,138 @@ struct st_maria_plugin	i_s_innodb_tablespaces_encryption =
 	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
 	MariaDB_PLUGIN_MATURITY_STABLE
 };
+
+namespace Show {
+/**  INNODB_ADAPTIVE_HASH_INDEXES  ************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES */
+static ST_FIELD_INFO innodb_adaptive_hash_indexes_fields_info[]=
+{
+#define AHI_INDEX_ID		0
+  Column("INDEX_ID", ULonglong(), NOT_NULL),
+
+#define AHI_TABLE_NAME		1
+  Column("TABLE_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_INDEX_NAME		2
+  Column("INDEX_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_EXCLUDED		3
+  Column("EXCLUDED", SLong(1), NOT_NULL),
+
+#define AHI_PAGES		4
+  Column("PAGES", ULonglong(), NOT_NULL),
+
+#define AHI_HITS		5
+  Column("HITS", ULonglong(), NOT_NULL),
+
+#define AHI_MAINTENANCE		6
+  Column("MAINTENANCE", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES
+with the adaptive hash index counters of the cached indexes.
+@return 0 on success */
+static int i_s_adaptive_hash_indexes_fill(THD *thd, TABLE_LIST *tables, Item*)
+{
+  DBUG_ENTER("i_s_adaptive_hash_indexes_fill");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+#ifdef BTR_CUR_HASH_ADAPT
+  struct row
+  {
+    index_id_t id;
+    std::string table_name;
+    std::string index_name;
+    bool excluded;
+    size_t pages, hits, maintenance;
+  };
+  std::vector<row> rows;
+
+  /* Copy the counters, so that dict_sys.latch is not held while
+  the rows are being stored. */
+  dict_sys.freeze(SRW_LOCK_CALL);
+  for (const auto &list : {dict_sys.table_LRU, dict_sys.table_non_LRU})
+    for (const dict_table_t *table= UT_LIST_GET_FIRST(list); table;
+         table= UT_LIST_GET_NEXT(table_LRU, table))
+      for (const dict_index_t *index= UT_LIST_GET_FIRST(table->indexes);
+           index; index= UT_LIST_GET_NEXT(indexes, index))
+        if (index->is_btree() && index->is_committed())
+          rows.push_back({index->id, table->name.m_name, index->name(),
+                          index->search_info.excluded,
+                          index->search_info.ref_count,
+                          index->search_info.hits,
+                          index->search_info.maintenance});
+  dict_sys.unfreeze();
+
+  Field **fields= tables->table->field;
+  for (const row &r : rows)
+  {
+    OK(fields[AHI_INDEX_ID]->store(longlong(r.id), true));
+    OK(field_store_string(fields[AHI_TABLE_NAME], r.table_name.c_str()));
+    OK(field_store_string(fields[AHI_INDEX_NAME], r.index_name.c_str()));
+    OK(fields[AHI_EXCLUDED]->store(r.excluded, true));
+    OK(fields[AHI_PAGES]->store(r.pages, true));
+    OK(fields[AHI_HITS]->store(r.hits, true));
+    OK(fields[AHI_MAINTENANCE]->store(r.maintenance, true));
+    OK(schema_table_store_record(thd, tables->table));
+  }
+#endif /* BTR_CUR_HASH_ADAPT */
+
+  DBUG_RETURN(0);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES
+@return 0 on success */
+static int innodb_adaptive_hash_indexes_init(void *p)
+{
+  DBUG_ENTER("innodb_adaptive_hash_indexes_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_adaptive_hash_indexes_fields_info;
+  schema->fill_table= i_s_adaptive_hash_indexes_fill;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_adaptive_hash_indexes =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_ADAPTIVE_HASH_INDEXES",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB adaptive hash index usage per index",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_adaptive_hash_indexes_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
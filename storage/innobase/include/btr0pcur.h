@@ -346,6 +346,13 @@ struct btr_pcur_t
   byte *old_rec_buf= nullptr;
   /** old_rec_buf size if old_rec_buf is not NULL */
   ulint buf_size= 0;
+  /** number of leaf pages following the current one that
+  btr_pcur_move_to_next_page() has requested to be read ahead */
+  uint32_t read_ahead_pending= 0;
+  /** number of leaf pages that btr_pcur_move_to_next_page() currently
+  reads ahead; 0 until the scan encounters a page that is not in the
+  buffer pool, and at most innodb_read_ahead_scan_depth */
+  uint32_t read_ahead_depth= 0;
 
   /** Return the index of this persistent cursor */
   dict_index_t *index() const { return(btr_cur.index()); }
@@ -388,6 +395,8 @@ struct btr_pcur_t
     search_mode= first ? PAGE_CUR_G : PAGE_CUR_L;
     pos_state= BTR_PCUR_IS_POSITIONED;
     old_rec= nullptr;
+    read_ahead_pending= 0;
+    read_ahead_depth= 0;
 
     return btr_cur.open_leaf(first, index, this->latch_mode, mtr);
   }
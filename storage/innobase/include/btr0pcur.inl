@@ -319,6 +319,8 @@ dberr_t btr_pcur_open_with_no_init(const dtuple_t *tuple, page_cur_mode_t mode,
   cursor->search_mode= mode;
   cursor->pos_state= BTR_PCUR_IS_POSITIONED;
   cursor->trx_if_known= nullptr;
+  cursor->read_ahead_pending= 0;
+  cursor->read_ahead_depth= 0;
   return cursor->btr_cur.search_leaf(tuple, mode, latch_mode, mtr);
 }
 
@@ -760,6 +760,15 @@ class buf_page_t
     ut_ad(f < WRITE_FIX);
   }
 
+  /** Complete a read whose contents were copied from buf_ccache. */
+  void read_complete_cached() noexcept
+  {
+    ut_d(const auto f=) zip.fix.fetch_sub(READ_FIX - UNFIXED);
+    ut_ad(f > READ_FIX);
+    ut_ad(f < WRITE_FIX);
+    lock.x_unlock(true);
+  }
+
   uint32_t fix(uint32_t count= 1) noexcept
   {
     ut_ad(count);
@@ -1384,6 +1393,64 @@ class buf_pool_t
   /** old statistics; protected by mutex */
   buf_pool_stat_t old_stat;
 
+#ifdef HAVE_LIBNUMA
+  /** Maximum number of NUMA nodes for innodb_numa_node_local */
+  static constexpr uint NUMA_MAX_NODES= 8;
+
+  /** Page access statistics of a NUMA node */
+  struct numa_stat_t
+  {
+    /** number of page requests from threads running on the node */
+    ib_counter_t<ulint> n_page_gets;
+    /** n_page_gets for a page frame that is on another node */
+    ib_counter_t<ulint> n_page_gets_remote;
+    /** number of pages read into page frames of the node */
+    Atomic_counter<ulint> n_pages_read;
+    /** n_page_gets and n_pages_read at buf_refresh_io_stats() */
+    ulint old_n_page_gets, old_n_pages_read;
+  };
+
+  /** Number of NUMA nodes that the extents of the buffer pool are
+  distributed over (extent i is on numa_nodes[i % numa_n_nodes]);
+  0 if innodb_numa_node_local is not in effect */
+  uint numa_n_nodes;
+  /** NUMA node numbers */
+  int numa_nodes[NUMA_MAX_NODES];
+  /** statistics, indexed like numa_nodes[] */
+  numa_stat_t numa_stat[NUMA_MAX_NODES];
+private:
+  /** numa_nodes[] index of each CPU */
+  byte *numa_cpu_node;
+  /** number of elements in numa_cpu_node[] */
+  uint numa_n_cpus;
+
+  /** Distribute the extents over the NUMA nodes (innodb_numa_node_local) */
+  void numa_create() noexcept;
+  /** Order the free list so that consecutive blocks are on different
+  NUMA nodes */
+  void numa_interleave_free() noexcept;
+  /** Find a free block on the NUMA node of the current thread.
+  @param first  the first block of the free list
+  @return a block near the start of free, preferably on the current node */
+  buf_page_t *numa_local_free(buf_page_t *first) const noexcept;
+public:
+  /** @return numa_nodes[] index of an address inside the buffer pool */
+  uint numa_node(const void *ptr) const noexcept
+  {
+    ut_ad(numa_n_nodes);
+    return uint(size_t(static_cast<const char*>(ptr) - memory) /
+                innodb_buffer_pool_extent_size % numa_n_nodes);
+  }
+  /** @return numa_nodes[] index of the node the current thread runs on */
+  uint numa_current_node() const noexcept;
+  /** @return number of blocks on a NUMA node
+  @param node  numa_nodes[] index */
+  size_t numa_curr_size(uint node) const noexcept;
+  /** Account for a page request
+  @param bpage  the requested page */
+  void numa_page_get(const buf_page_t &bpage) noexcept;
+#endif /* HAVE_LIBNUMA */
+
 	/** @name General fields */
 	/* @{ */
 	ulint		LRU_old_ratio;  /*!< Reserve this much of the buffer
@@ -1491,6 +1558,14 @@ class buf_pool_t
   /** number of index page splits */
   Atomic_counter<ulint> pages_split;
 
+  /** number of pages that index scans requested to be read ahead */
+  Atomic_counter<ulint> scan_read_ahead;
+  /** number of leaf pages that an index scan found in the buffer pool
+  when accessing them for the first time */
+  Atomic_counter<ulint> scan_read_ahead_hits;
+  /** number of leaf pages that an index scan had to read on demand */
+  Atomic_counter<ulint> scan_read_ahead_misses;
+
   /** @name Page flushing algorithm fields */
   /* @{ */
 
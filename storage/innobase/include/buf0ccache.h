@@ -0,0 +1,189 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/buf0ccache.h
+Compressed cache of pages that were evicted from the buffer pool
+*******************************************************/
+
+#pragma once
+
+#include "buf0types.h"
+#include "srw_lock.h"
+#include "ut0lst.h"
+#include "ut0new.h"
+#include <unordered_map>
+
+/** A second-level cache that keeps compressed copies of clean pages that
+were evicted from buf_pool.LRU (innodb_compressed_cache_size).
+When a page that is not in buf_pool.page_hash is being read, its copy is
+decompressed instead of reading the data file.
+
+A valid copy of a page only exists while the page is not in
+buf_pool.page_hash: buf_page_t::read_complete() is bypassed and
+the copy is removed when the page is read back. Any copy of a page
+is replaced when the page is evicted again. */
+class buf_ccache_t
+{
+  /** A compressed page */
+  struct entry
+  {
+    entry(const page_id_t id) : id(id) {}
+    /** page identifier */
+    const page_id_t id;
+    /** position in shard::LRU */
+    UT_LIST_NODE_T(entry) LRU;
+    /** compressed length in bytes */
+    uint32_t len;
+    /** whether the page was compressed with LZ4 (instead of zlib) */
+    bool lz4;
+    /** @return the compressed page */
+    byte *data() noexcept { return reinterpret_cast<byte*>(this + 1); }
+  };
+
+  struct hasher
+  {
+    size_t operator()(const page_id_t &id) const { return size_t(id.raw()); }
+  };
+
+  /** An element of shard::pages */
+  struct slot
+  {
+    /** the cached page, or nullptr if the page is being evicted by
+    buf_LRU_free_page() and add() has not been invoked yet */
+    entry *page;
+    /** the reservation made by reserve() */
+    size_t ticket;
+  };
+
+  /** map of cached or reserved pages */
+  using page_map=
+    std::unordered_map<page_id_t, slot, hasher,
+#if defined __GNUC__ && __GNUC__ == 4 && __GNUC_MINOR__ >= 8
+                       std::equal_to<page_id_t>
+                       /* GCC 4.8.5 would fail to find a matching allocator */
+#else
+                       std::equal_to<page_id_t>,
+                       ut_allocator<std::pair<const page_id_t, slot>>
+#endif
+                       >;
+
+  /** A partition of the cache */
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) shard
+  {
+    /** protects the rest of the members */
+    srw_mutex mutex;
+    /** cached or reserved pages */
+    page_map pages;
+    /** cached pages, the most recently added first */
+    UT_LIST_BASE_NODE_T(entry) LRU;
+    /** total length of the cached pages */
+    size_t bytes;
+    /** the most recently issued reservation */
+    size_t last_ticket;
+  };
+
+  /** number of partitions of the cache */
+  static constexpr size_t N_SHARDS= 16;
+
+  /** the partitions of the cache */
+  shard shards[N_SHARDS];
+  /** whether create() has been invoked */
+  bool m_initialised= false;
+
+  /** @return the partition that a page belongs to */
+  shard &get_shard(const page_id_t id) noexcept
+  { return shards[id.fold() % N_SHARDS]; }
+
+  /** Remove an entry from a shard.
+  @param s  shard whose mutex is being held
+  @param e  entry to be removed from s.LRU (but not from s.pages) */
+  void remove_low(shard &s, entry *e) noexcept;
+
+  /** Evict the least recently added pages from a shard.
+  @param s      shard whose mutex is being held
+  @param limit  maximum size of the shard in bytes */
+  void shrink_low(shard &s, size_t limit) noexcept;
+
+  /** Compress a page.
+  @param id     page identifier
+  @param frame  uncompressed page
+  @return compressed page
+  @retval nullptr if the page does not compress well enough */
+  static entry *compress(const page_id_t id, const byte *frame) noexcept;
+
+public:
+  /** innodb_compressed_cache_size; 0 if the cache is disabled */
+  size_t max_size;
+
+  /** number of page reads that were satisfied from the cache */
+  Atomic_counter<ulint> hits;
+  /** number of page reads that were not satisfied from the cache */
+  Atomic_counter<ulint> misses;
+  /** number of cached pages */
+  Atomic_counter<ulint> n_pages;
+  /** total length of the cached pages in bytes */
+  Atomic_counter<ulint> n_bytes;
+
+  /** Initialise the cache */
+  void create() noexcept;
+  /** Free all cached pages and the cache */
+  void close() noexcept;
+
+  /** @return whether the cache is enabled */
+  bool enabled() const noexcept { return max_size != 0; }
+
+  /** Change innodb_compressed_cache_size.
+  @param size  maximum size of the cache in bytes; 0 to disable it */
+  void resize(size_t size) noexcept;
+
+  /** Reserve an entry for a page that is about to be evicted.
+  The caller must hold buf_pool.mutex and an exclusive page_hash latch,
+  and the page must be clean.
+  @param bpage  page that is about to be removed from buf_pool.page_hash
+  @return the reservation to pass to add()
+  @retval 0 if the page will not be cached */
+  size_t reserve(const buf_page_t &bpage) noexcept;
+
+  /** Add a copy of an evicted page, unless a read of the page was
+  attempted after reserve().
+  The caller must not hold buf_pool.mutex.
+  @param id      page identifier
+  @param ticket  return value of reserve()
+  @param frame   contents of the page; FIL_PAGE_OFFSET and FIL_PAGE_SPACE_ID
+                 that buf_LRU_block_remove_hashed() overwrote will be
+                 restored */
+  void add(const page_id_t id, size_t ticket, byte *frame) noexcept;
+
+  /** Look up and remove a cached page.
+  @param id     page identifier
+  @param frame  buffer for the decompressed page
+  @return whether the page was found and copied to frame */
+  bool get(const page_id_t id, byte *frame) noexcept;
+
+  /** Discard any copy or reservation of a page.
+  @param id     page identifier */
+  void invalidate(const page_id_t id) noexcept;
+
+  /** Discard all cached pages of a tablespace that is being dropped.
+  @param space_id  tablespace identifier */
+  void remove_space(uint32_t space_id) noexcept;
+};
+
+/** The compressed page cache */
+extern buf_ccache_t buf_ccache;
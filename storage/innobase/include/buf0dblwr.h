@@ -40,6 +40,20 @@ class buf_dblwr_t
     size_t size;
   };
 
+  /** State of a write batch */
+  enum batch_state : uint8_t
+  {
+    /** the slot is empty or being filled by add_to_batch() */
+    BATCH_IDLE= 0,
+    /** the slot is being written to the doublewrite buffer */
+    BATCH_DBLWR,
+    /** the doublewrite buffer has been made durable, and the data pages
+    will be written once the other slot has completed its batch */
+    BATCH_READY,
+    /** the data pages are being written */
+    BATCH_PAGES
+  };
+
   struct slot
   {
     /** first free position in write_buf measured in units of
@@ -51,6 +65,8 @@ class buf_dblwr_t
     byte* write_buf;
     /** buffer blocks to be written via write_buf */
     element* buf_block_arr;
+    /** state of the write batch */
+    batch_state state;
   };
 
   /** the page number of the first doublewrite block (block_size pages) */
@@ -60,10 +76,8 @@ class buf_dblwr_t
 
   /** mutex protecting the data members below */
   mysql_mutex_t mutex;
-  /** condition variable for !batch_running */
+  /** condition variable for changes of slot::state */
   pthread_cond_t cond;
-  /** whether a batch is being written from the doublewrite buffer */
-  bool batch_running;
   /** number of expected flush_buffered_writes_completed() calls */
   unsigned flushing_buffered_writes;
   /** number of flush_buffered_writes_completed() calls */
@@ -72,6 +86,8 @@ class buf_dblwr_t
   ulint pages_written;
 
   slot slots[2];
+  /** the slot that add_to_batch() fills; with innodb_doublewrite_pipeline
+  this may still be in use by a previous batch */
   slot *active_slot;
 
   /** Size of the doublewrite block in pages */
@@ -94,9 +110,24 @@ class buf_dblwr_t
   @param header   doublewrite page header in the TRX_SYS page */
   inline void init(const byte *header) noexcept;
 
+  /** @return the number of pages in a write batch */
+  inline ulint batch_size() const noexcept;
+
+  /** @return whether a write batch is in progress */
+  bool batch_running() const noexcept
+  { return slots[0].state != BATCH_IDLE || slots[1].state != BATCH_IDLE; }
+
+  /** @return the slot that is not s */
+  slot *other(const slot *s) noexcept
+  { return s == &slots[0] ? &slots[1] : &slots[0]; }
+
   /** Flush possible buffered writes to persistent storage. */
   bool flush_buffered_writes(const ulint size) noexcept;
 
+  /** Write the data pages of a batch whose doublewrite copy is durable.
+  @param s   the slot in BATCH_PAGES state */
+  void write_pages(const slot &s) noexcept;
+
 public:
   /** Initialise the doublewrite buffer data structures. */
   void init() noexcept;
@@ -181,7 +212,7 @@ class buf_dblwr_t
   void wait_flush_buffered_writes() noexcept
   {
     mysql_mutex_lock(&mutex);
-    while (batch_running)
+    while (batch_running())
       my_cond_wait(&cond, &mutex.m_mutex);
     mysql_mutex_unlock(&mutex);
   }
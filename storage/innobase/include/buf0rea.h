@@ -87,6 +87,18 @@ latches!
 @return number of page read requests issued */
 ulint buf_read_ahead_linear(const page_id_t page_id) noexcept;
 
+/** Read ahead the leaf pages that an index scan is about to access.
+The pages do not need to be adjacent; see btr_pcur_move_to_next_page().
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param space_id  tablespace identifier
+@param pages     page numbers
+@param n         number of pages
+@return number of page read requests issued */
+ulint buf_read_ahead_scan(uint32_t space_id, const uint32_t *pages, size_t n)
+  noexcept;
+
 /** Schedule a page for recovery.
 @param space    tablespace
 @param page_id  page identifier
@@ -43,6 +43,7 @@ Created 1/8/1996 Heikki Tuuri
 #include "trx0types.h"
 #include "fts0fts.h"
 #include "buf0buf.h"
+#include "ut0counter.h"
 #include "mtr0mtr.h"
 #include "gis0type.h"
 #include "fil0fil.h"
@@ -1094,6 +1095,25 @@ struct dict_index_t {
     /** number of buf_block_t::index pointers to this index */
     Atomic_counter<size_t> ref_count{0};
 
+    /** whether btr_search_admit() excluded the index from the
+    adaptive hash index */
+    Atomic_relaxed<bool> excluded{false};
+    /** number of sampled searches and modifications in the current
+    sampling window */
+    Atomic_relaxed<uint32_t> window_samples{0};
+    /** searches in the current sampling window that were satisfied by
+    the adaptive hash index, or would have been if !excluded */
+    Atomic_relaxed<uint32_t> window_hits{0};
+    /** modifications in the current sampling window that had to (or,
+    if excluded, could have to) update the adaptive hash index */
+    Atomic_relaxed<uint32_t> window_maintenance{0};
+    /** estimated number of searches that were satisfied by the
+    adaptive hash index */
+    ib_padded_counter_t<size_t> hits;
+    /** estimated number of adaptive hash index updates caused by
+    modifications */
+    ib_padded_counter_t<size_t> maintenance;
+
 #  ifdef UNIV_SEARCH_PERF_STAT
     /** number of successful hash searches */
     size_t n_hash_succ{0};
@@ -398,6 +398,10 @@ struct recv_sys_t
   @param last_batch     whether it is possible to write more redo log */
   void apply(bool last_batch);
 
+  /** @return the maximum number of tasks that apply log records to pages
+  concurrently (innodb_log_recovery_threads) */
+  static uint apply_threads() noexcept;
+
 #ifdef UNIV_DEBUG
   /** whether all redo log in the current batch has been applied */
   bool after_apply= false;
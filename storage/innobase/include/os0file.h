@@ -994,6 +994,11 @@ int os_aio_init() noexcept;
 Frees the asynchronous io system. */
 void os_aio_free() noexcept;
 
+/** Set the maximum number of concurrently executing read completion
+callbacks. During crash recovery, the callbacks apply the redo log.
+@param n  maximum number of callbacks; 0 for innodb_read_io_threads */
+void os_aio_set_read_concurrency(uint n) noexcept;
+
 /** Submit a fake read request during crash recovery.
 @param type   fake read request
 @param offset additional context */
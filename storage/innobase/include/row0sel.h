@@ -178,6 +178,21 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/** Count the records of the clustered index that are visible in the
+read view of the transaction. The index is split into key ranges at
+the node pointers of its upper levels, and the ranges are scanned
+concurrently by up to n_threads tasks that share the read view.
+
+@param prebuilt    table and transaction
+@param n_threads   maximum number of concurrent scans
+@param n_rows      number of records counted
+@param n_ranges    number of key ranges the index was split into
+
+@return error code */
+dberr_t row_count_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                           ulint *n_rows, ulint *n_ranges)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
@@ -170,6 +170,9 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Maximum number of secondary indexes that are sorted and loaded
+concurrently in index creation */
+extern uint	srv_ddl_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -185,10 +188,15 @@ extern ulong	srv_linux_aio_method;
 #endif
 
 extern my_bool	srv_numa_interleave;
+extern my_bool	srv_numa_node_local;
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
 
+/** innodb_doublewrite_pipeline: whether to write the next doublewrite
+batch while the data pages of the previous batch are being written */
+extern my_bool srv_doublewrite_pipeline;
+
 /* Compression algorithm*/
 extern ulong innodb_compression_algorithm;
 
@@ -242,8 +250,13 @@ extern ulint	srv_lock_table_size;
 extern ulong	srv_checksum_algorithm;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_scan_depth: maximum number of leaf pages that an
+index scan reads ahead, or 0 to disable */
+extern uint	srv_read_ahead_scan_depth;
 extern uint	srv_n_read_io_threads;
 extern uint	srv_n_write_io_threads;
+/** innodb_log_recovery_threads; 0 for the number of CPUs */
+extern uint	srv_log_recovery_threads;
 
 /* Number of IO operations per second the server can do */
 extern ulong    srv_io_capacity;
@@ -621,6 +634,11 @@ struct export_var_t{
 	/* Number of InnoDB bulk operations */
 	Atomic_counter<ulint> innodb_bulk_operations;
 
+	/** Number of parallel scans done by ha_innobase::records() */
+	Atomic_counter<ulint> innodb_parallel_scans;
+	/** Number of key ranges scanned by those parallel scans */
+	Atomic_counter<ulint> innodb_parallel_scan_ranges;
+
 	ulint innodb_onlineddl_rowlog_rows;	/*!< Online alter rows */
 	ulint innodb_onlineddl_rowlog_pct_used; /*!< Online alter percentage
 						of used row log buffer */
@@ -345,6 +345,11 @@ struct trx_lock_t
   void set_wsrep_victim() { was_chosen_as_deadlock_victim= true; }
 #endif /* defined(UNIV_DEBUG) || !defined(DBUG_OFF) */
 
+  /** The granted record lock that lock_rec_lock() last acquired or
+  extended, or nullptr. Only accessed by the thread that is executing
+  the transaction; reset when the locks are released. */
+  const ib_lock_t *last_rec_lock;
+
   /** Next available rec_pool[] entry */
   byte rec_cached;
   /** Next available table_pool[] entry */
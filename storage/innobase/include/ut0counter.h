@@ -96,4 +96,41 @@ struct ib_counter_t {
 	alignas(CPU_LEVEL1_DCACHE_LINESIZE) Element<Type> m_counter[N];
 };
 
+/** Fuzzy counter like ib_counter_t, for objects that are not allocated
+with the alignment of a cache line, such as those in a mem_heap_t. Each
+slot is padded to the size of a cache line, so that no two slots share
+one. */
+template <typename Type, int N = 4>
+struct ib_padded_counter_t {
+	/** Add to the counter.
+	@param[in]	n	amount to be added */
+	void add(Type n) { add(size_t(my_pseudo_random()), n); }
+
+	/** Add to the counter.
+	@param[in]	index	a reasonably thread-unique identifier
+	@param[in]	n	amount to be added */
+	TPOOL_SUPPRESS_TSAN void add(size_t index, Type n) {
+		m_counter[index % N].value += n;
+	}
+
+	/* @return total value - not 100% accurate, since it is relaxed atomic*/
+	operator Type() const {
+		Type	total = 0;
+		for (const auto &counter : m_counter) {
+			total += counter.value;
+		}
+		return(total);
+	}
+
+private:
+	struct element {
+		Atomic_relaxed<Type>	value{0};
+		char	pad[CPU_LEVEL1_DCACHE_LINESIZE
+			    - sizeof(Atomic_relaxed<Type>)];
+	};
+	static_assert(sizeof(element) == CPU_LEVEL1_DCACHE_LINESIZE, "");
+	/** Array of counter elements */
+	element m_counter[N];
+};
+
 #endif /* ut0counter_h */
@@ -839,6 +839,7 @@ constexpr const char* const auto_event_names[] =
   "btr0pcur",
   "btr0sea",
   "buf0buf",
+  "buf0ccache",
   "buf0dblwr",
   "buf0dump",
   "buf0lru",
@@ -1919,6 +1919,26 @@ lock_rec_lock(
                      static_cast<lock_mode>(LOCK_MODE_MASK & mode)))
     return DB_SUCCESS;
 
+  /* Check without acquiring lock_sys.latch whether the lock that was last
+  acquired by this function already covers the record. This is common when
+  a transaction revisits the rows that it locked, for example in UPDATE
+  after SELECT...FOR UPDATE. The bitmap of a granted lock is only modified
+  while holding the trx->mutex of its owner or an exclusive latch on the
+  page, and our caller is holding a latch on the page. */
+  if (const lock_t *lock= trx->lock.last_rec_lock)
+  {
+    trx->mutex_lock();
+    const bool held= lock->type_mode == mode &&
+      lock->un_member.rec_lock.page_id == block->page.id() &&
+      lock_rec_get_nth_bit(lock, heap_no);
+    trx->mutex_unlock();
+    if (held)
+    {
+      MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+      return DB_SUCCESS;
+    }
+  }
+
   /* During CREATE TABLE, we will write to newly created FTS_*_CONFIG
   on which no lock has been created yet. */
   ut_ad(!trx->dict_operation_lock_mode ||
@@ -1995,6 +2015,7 @@ lock_rec_lock(
         lock_rec_set_nth_bit(lock, heap_no);
         err= DB_SUCCESS_LOCKED_REC;
       }
+      trx->lock.last_rec_lock= lock;
     }
     trx->mutex_unlock();
     return err;
@@ -2002,8 +2023,9 @@ lock_rec_lock(
 
   /* Simplified and faster path for the most common cases */
   if (!impl)
-    lock_rec_create(null_c_lock_info, mode, id, block->page.frame, heap_no,
-                    index, trx, false);
+    trx->lock.last_rec_lock=
+      lock_rec_create(null_c_lock_info, mode, id, block->page.frame, heap_no,
+                      index, trx, false);
 
   return DB_SUCCESS_LOCKED_REC;
 }
@@ -4582,6 +4604,7 @@ static bool lock_release_try(trx_t *trx)
 and release possible other transactions waiting because of these locks. */
 void lock_release(trx_t *trx)
 {
+  trx->lock.last_rec_lock= nullptr;
 #ifdef UNIV_DEBUG
   std::set<table_id_t> to_evict;
   if (innodb_evict_tables_on_commit_debug &&
@@ -4663,6 +4686,7 @@ dict_sys.latch is exclusively locked,
 and release possible other transactions waiting because of these locks. */
 void lock_release_on_drop(trx_t *trx)
 {
+  trx->lock.last_rec_lock= nullptr;
   ut_ad(lock_sys.is_writer());
   ut_ad(trx->mutex_is_owner());
   ut_ad(trx->dict_operation);
@@ -4990,6 +5014,7 @@ lock_trx_table_locks_remove(
 and release possible other transactions waiting because of these locks. */
 void lock_release_on_prepare(trx_t *trx)
 {
+  trx->lock.last_rec_lock= nullptr;
   trx->set_skip_lock_inheritance();
   bool unlock_unmodified=
 #ifdef HAVE_REPLICATION
@@ -5112,6 +5137,7 @@ void lock_release_on_prepare(trx_t *trx)
 ATTRIBUTE_COLD
 void lock_release_on_rollback(trx_t *trx, dict_table_t *table)
 {
+  trx->lock.last_rec_lock= nullptr;
   trx->mod_tables.erase(table);
 
   /* This is very rarely executed code, in the rare case that an
@@ -28,6 +28,7 @@ Created 9/20/1997 Heikki Tuuri
 
 #include <map>
 #include <string>
+#include <thread>
 #include <my_service_manager.h>
 
 #include "log0recv.h"
@@ -4067,6 +4068,15 @@ static void log_sort_flush_list() noexcept
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 }
 
+/** @return the number of recovery threads: innodb_log_recovery_threads,
+or if it is 0, the number of CPUs but at least innodb_read_io_threads */
+uint recv_sys_t::apply_threads() noexcept
+{
+  if (srv_log_recovery_threads)
+    return srv_log_recovery_threads;
+  return std::max(std::thread::hardware_concurrency(), srv_n_read_io_threads);
+}
+
 /** Apply buffered log to persistent data pages.
 @param last_batch     whether it is possible to write more redo log */
 void recv_sys_t::apply(bool last_batch)
@@ -4135,6 +4145,11 @@ void recv_sys_t::apply(bool last_batch)
 
     apply_log_recs= true;
 
+    /* The log records are applied by the read completion callbacks,
+    see buf_read_recover(). Let them run on all the CPUs instead of
+    innodb_read_io_threads. */
+    os_aio_set_read_concurrency(apply_threads());
+
     fil_system.extend_to_recv_size();
 
     fil_space_t *space= nullptr;
@@ -4177,6 +4192,7 @@ void recv_sys_t::apply(bool last_batch)
             mysql_mutex_unlock(&buf_pool.mutex);
             mysql_mutex_lock(&mutex);
           }
+          os_aio_set_read_concurrency(0);
           return;
         }
         if (apply_batch(space_id, space, free_block, last_batch))
@@ -4193,6 +4209,9 @@ void recv_sys_t::apply(bool last_batch)
       buf_LRU_block_free_non_file_page(free_block);
       mysql_mutex_unlock(&buf_pool.mutex);
     }
+
+    /* All pages have been read and recovered. */
+    os_aio_set_read_concurrency(0);
   }
 
   if (last_batch)
@@ -386,12 +386,6 @@ void mtr_t::commit_log(mtr_t *mtr, std::pair<lsn_t,lsn_t> lsns) noexcept
         ut_d(const auto s= b->page.state());
         ut_ad(s > buf_page_t::FREED);
         ut_ad(s < buf_page_t::READ_FIX);
-        ut_ad(mach_read_from_8(b->page.frame + FIL_PAGE_LSN) <=
-              mtr->m_commit_lsn);
-        mach_write_to_8(b->page.frame + FIL_PAGE_LSN, mtr->m_commit_lsn);
-        if (UNIV_LIKELY_NULL(b->page.zip.data))
-          memcpy_aligned<8>(FIL_PAGE_LSN + b->page.zip.data,
-                            FIL_PAGE_LSN + b->page.frame, 8);
         buf_pool.insert_into_flush_list(prev, b, lsns.first);
       }
     }
@@ -402,6 +396,25 @@ void mtr_t::commit_log(mtr_t *mtr, std::pair<lsn_t,lsn_t> lsns) noexcept
     mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 
     mtr->commit_log_release();
+
+    /* Stamp the pages after releasing log_sys.latch and
+    buf_pool.flush_list_mutex, so that other threads can proceed with
+    their mtr_t::commit() while we are writing to the page frames. The
+    page writes in buf_flush_page() will wait for our page latches. */
+    for (it= mtr->m_memo.rbegin(); it != mtr->m_memo.rend(); it++)
+    {
+      if (it->type & MTR_MEMO_MODIFY)
+      {
+        buf_block_t *b= static_cast<buf_block_t*>(it->object);
+        ut_ad(mach_read_from_8(b->page.frame + FIL_PAGE_LSN) <=
+              mtr->m_commit_lsn);
+        mach_write_to_8(b->page.frame + FIL_PAGE_LSN, mtr->m_commit_lsn);
+        if (UNIV_LIKELY_NULL(b->page.zip.data))
+          memcpy_aligned<8>(FIL_PAGE_LSN + b->page.zip.data,
+                            FIL_PAGE_LSN + b->page.frame, 8);
+      }
+    }
+
     mtr->release();
   }
   else
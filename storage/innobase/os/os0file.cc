@@ -3173,6 +3173,11 @@ int os_aio_resize(ulint n_reader_threads, ulint n_writer_threads) noexcept
   return ret;
 }
 
+void os_aio_set_read_concurrency(uint n) noexcept
+{
+  read_slots->task_group().set_max_tasks(n ? n : srv_n_read_io_threads);
+}
+
 void os_aio_free() noexcept
 {
   delete read_slots;
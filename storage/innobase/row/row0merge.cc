@@ -3845,7 +3845,7 @@ row_merge_insert_index_tuples(
 
 		/* Increment innodb_onlineddl_pct_progress status variable */
 		inserted_rows++;
-		if(inserted_rows % 1000 == 0) {
+		if (pct_cost > 0 && inserted_rows % 1000 == 0) {
 			/* Update progress for each 1000 rows */
 			curr_progress = (inserted_rows >= table_total_rows ||
 				table_total_rows <= 0) ?
@@ -4564,6 +4564,230 @@ row_merge_is_index_usable(
 		   || trx->read_view.changes_visible(index->trx_id)));
 }
 
+/** A secondary index that is sorted and loaded by
+row_merge_build_parallel() */
+struct row_merge_job_t
+{
+	/** the index, or NULL if the index is built by
+	row_merge_build_indexes() itself */
+	dict_index_t*	index;
+	/** merge file of the index */
+	merge_file_t*	file;
+	/** outcome of sorting and loading the index */
+	dberr_t		error;
+};
+
+/** State shared by the tasks of row_merge_build_parallel() */
+struct row_merge_parallel_t
+{
+	trx_t*			trx;
+	const dict_table_t*	old_table;
+	/** MySQL table, for row_merge_dup_t */
+	TABLE*			table;
+	/** mapping of column numbers, for row_merge_dup_t */
+	const ulint*		col_map;
+	/** tablespace of the indexes */
+	ulint			space;
+	/** location for creating temporary files */
+	const char*		path;
+	/** jobs, indexed like the indexes[] of row_merge_build_indexes() */
+	row_merge_job_t*	jobs;
+	/** size of jobs[] */
+	ulint			n_jobs;
+	/** the next element of jobs[] to be examined */
+	std::atomic<ulint>	next;
+};
+
+/** Sort and load secondary indexes until no jobs are left.
+Each task uses buffers and a temporary file of its own.
+@param arg	row_merge_parallel_t */
+static void row_merge_parallel_worker(void* arg)
+{
+	row_merge_parallel_t*	p = static_cast<row_merge_parallel_t*>(arg);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const size_t		block_size = 3 * srv_sort_buf_size;
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+	row_merge_block_t*	block = alloc.allocate_large(block_size,
+							     &block_pfx);
+
+	crypt_pfx.m_size = 0; /* silence bogus -Wmaybe-uninitialized */
+	if (block && srv_encrypt_log) {
+		crypt_block = alloc.allocate_large(block_size, &crypt_pfx);
+	}
+
+	for (ulint i; (i = p->next.fetch_add(1, std::memory_order_relaxed))
+		     < p->n_jobs; ) {
+		row_merge_job_t*	job = &p->jobs[i];
+
+		if (!job->index) {
+			continue;
+		}
+
+		if (!block || (srv_encrypt_log && !crypt_block)
+		    || !row_merge_tmpfile_if_needed(&tmpfd, p->path)) {
+			job->error = DB_OUT_OF_MEMORY;
+			continue;
+		}
+
+		row_merge_dup_t	dup = {
+			job->index, p->trx, p->table, p->col_map, 0};
+
+		/* Progress is reported by row_merge_build_indexes()
+		once the index has been built. */
+		job->error = row_merge_sort(p->trx, &dup, job->file, block,
+					    &tmpfd, false, 0, 0, crypt_block,
+					    p->space, NULL);
+
+		if (job->error == DB_SUCCESS) {
+			BtrBulk	btr_bulk(job->index, p->trx);
+
+			job->error = btr_bulk.finish(
+				row_merge_insert_index_tuples(
+					p->trx, job->index, p->old_table,
+					job->file->fd, block, NULL,
+					&btr_bulk, job->file->n_rec, 0, 0,
+					crypt_block, p->space));
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx);
+	}
+}
+
+/** Sort and load the non-unique secondary indexes concurrently, after
+row_merge_read_clustered_index() has written their merge files.
+Unique indexes are left to row_merge_build_indexes(), because reporting
+a duplicate key writes to the MySQL TABLE.
+@param[in]	trx		transaction
+@param[in]	old_table	table where rows are read from
+@param[in]	new_table	table where indexes are created
+@param[in]	indexes		indexes to be created
+@param[in]	n_indexes	size of indexes[]
+@param[in,out]	table		MySQL table
+@param[in]	col_map		mapping of old column numbers to new ones
+@param[in,out]	merge_files	merge files of the indexes
+@return the jobs, indexed like indexes[]; to be freed with ut_free()
+@retval NULL if the indexes should be built one at a time */
+static row_merge_job_t*
+row_merge_build_parallel(
+	trx_t*			trx,
+	const dict_table_t*	old_table,
+	const dict_table_t*	new_table,
+	dict_index_t**		indexes,
+	ulint			n_indexes,
+	TABLE*			table,
+	const ulint*		col_map,
+	merge_file_t*		merge_files)
+{
+	const ulint	n_threads = srv_ddl_threads;
+
+	if (n_threads <= 1 || n_indexes <= 1) {
+		return NULL;
+	}
+
+	row_merge_job_t*	jobs = static_cast<row_merge_job_t*>(
+		ut_malloc_nokey(n_indexes * sizeof *jobs));
+
+	if (!jobs) {
+		return NULL;
+	}
+
+	ulint	n_jobs = 0;
+
+	for (ulint k = 0, i = 0; i < n_indexes; i++) {
+		dict_index_t*	index = indexes[i];
+
+		jobs[i].index = NULL;
+		jobs[i].error = DB_SUCCESS;
+
+		if (dict_index_is_spatial(index)) {
+			continue;
+		}
+
+		merge_file_t*	file = &merge_files[k++];
+
+		if ((index->type & (DICT_FTS | DICT_CLUSTERED | DICT_UNIQUE))
+		    || file->fd == OS_FILE_CLOSED) {
+			continue;
+		}
+
+		jobs[i].index = index;
+		jobs[i].file = file;
+		n_jobs++;
+	}
+
+	if (n_jobs < 2) {
+		ut_free(jobs);
+		return NULL;
+	}
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : Start merge-sorting"
+				      " and building " ULINTPF " indexes"
+				      " concurrently", n_jobs);
+	}
+
+	row_merge_parallel_t	p;
+	p.trx = trx;
+	p.old_table = old_table;
+	p.table = table;
+	p.col_map = col_map;
+	p.space = new_table->space_id;
+	p.path = thd_innodb_tmpdir(trx->mysql_thd);
+	p.jobs = jobs;
+	p.n_jobs = n_indexes;
+	p.next = 0;
+
+	/* The workers share trx, and mtr_t::commit() and the page reads
+	would update trx->active_handler_stats without any protection.
+	The statistics are only attached during handler calls that
+	access rows, so nothing is counted here; detach them anyway. */
+	ha_handler_stats* const	stats = trx->active_handler_stats;
+	trx->active_handler_stats = NULL;
+
+	/* The current thread is one of the workers. */
+	const ulint	n_tasks = std::min(n_threads, n_jobs) - 1;
+	tpool::waitable_task**	tasks = static_cast<tpool::waitable_task**>(
+		ut_malloc_nokey(n_tasks * sizeof *tasks));
+
+	ulint	n_submitted = 0;
+
+	for (; tasks && n_submitted < n_tasks; n_submitted++) {
+		tasks[n_submitted] = new tpool::waitable_task(
+			row_merge_parallel_worker, &p);
+		srv_thread_pool->submit_task(tasks[n_submitted]);
+	}
+
+	row_merge_parallel_worker(&p);
+
+	for (ulint t = 0; t < n_submitted; t++) {
+		tasks[t]->wait();
+		delete tasks[t];
+	}
+
+	ut_free(tasks);
+
+	trx->active_handler_stats = stats;
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : End of"
+				      " merge-sorting and building "
+				      ULINTPF " indexes", n_jobs);
+	}
+
+	return jobs;
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4629,6 +4853,7 @@ row_merge_build_indexes(
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
+	row_merge_job_t*	jobs = NULL;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4803,6 +5028,10 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	jobs = row_merge_build_parallel(trx, old_table, new_table, indexes,
+					n_indexes, table, col_map,
+					merge_files);
+
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -4828,6 +5057,20 @@ row_merge_build_indexes(
 					psort_info, 0);
 			}
 
+		} else if (jobs && jobs[i].index) {
+			/* The index was sorted and loaded by
+			row_merge_build_parallel(). */
+			pct_progress += (COST_BUILD_INDEX_STATIC +
+					 (total_dynamic_cost
+					  * static_cast<double>(
+						  merge_files[k].offset)
+					  / static_cast<double>(
+						  total_index_blocks)))
+				/ (total_static_cost + total_dynamic_cost)
+				* (PCT_COST_MERGESORT_INDEX
+				   + PCT_COST_INSERT_INDEX) * 100;
+			onlineddl_pct_progress = ulint(pct_progress * 100);
+			error = jobs[i].error;
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
@@ -4974,6 +5217,8 @@ row_merge_build_indexes(
 		row_merge_file_destroy(&merge_files[i]);
 	}
 
+	ut_free(jobs);
+
 	if (fts_sort_idx) {
 		dict_mem_index_free(fts_sort_idx);
 	}
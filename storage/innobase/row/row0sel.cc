@@ -6847,3 +6847,311 @@ dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
 
   goto rec_loop;
 }
+
+/** Number of key ranges per task in row_count_parallel(). Splitting the
+index into more ranges than tasks lets the tasks balance uneven ranges. */
+static constexpr ulint ROW_COUNT_RANGES_PER_THREAD= 8;
+
+namespace
+{
+/** State shared by the tasks of row_count_parallel() */
+struct row_count_ctx
+{
+  /** the clustered index */
+  dict_index_t *index;
+  /** the transaction that is counting the records */
+  trx_t *trx;
+  /** the read view, or nullptr if all records that are not
+  delete-marked are to be counted */
+  ReadView *view;
+  /** range i consists of the records in [bounds[i - 1], bounds[i]);
+  the first range is not bounded below and the last one above */
+  const dtuple_t *const *bounds;
+  /** number of ranges */
+  ulint n_ranges;
+  /** the next range to be scanned */
+  std::atomic<ulint> next_range;
+  /** number of records counted */
+  Atomic_counter<ulint> n_rows;
+  /** the first error that was encountered */
+  std::atomic<dberr_t> err;
+
+  void set_error(dberr_t error)
+  {
+    dberr_t expected= DB_SUCCESS;
+    err.compare_exchange_strong(expected, error);
+  }
+};
+}
+
+/** Copy the key of a node pointer record as a range bound.
+@param rec    node pointer record
+@param index  clustered index
+@param heap   memory heap for the copy
+@return the search tuple */
+static const dtuple_t *row_count_copy_bound(const rec_t *rec,
+                                            dict_index_t *index,
+                                            mem_heap_t *heap)
+{
+  const ulint n_fields= dict_index_get_n_unique_in_tree_nonleaf(index);
+  dtuple_t *tuple= dtuple_create(heap, uint16_t(n_fields));
+  dict_index_copy_types(tuple, index, n_fields);
+  rec_copy_prefix_to_dtuple(tuple, rec, index, 0, n_fields, heap);
+  tuple->info_bits= 0;
+  return tuple;
+}
+
+/** Add up to max_bounds keys of the node pointer records of a non-leaf
+page as range bounds. The keys are picked evenly across the page.
+@param block       non-leaf page
+@param index       clustered index
+@param max_bounds  maximum number of keys to add
+@param bounds      ascending range bounds
+@param heap        memory heap for the bounds
+@return error code */
+static dberr_t row_count_page_bounds(const buf_block_t *block,
+                                     dict_index_t *index, ulint max_bounds,
+                                     std::vector<const dtuple_t*> &bounds,
+                                     mem_heap_t *heap)
+{
+  const page_t *page= block->page.frame;
+  const ulint n_recs= page_get_n_recs(page);
+  const bool comp= page_is_comp(page);
+  const rec_t *rec= page_get_infimum_rec(page);
+
+  for (ulint i= 0; i < n_recs; i++)
+  {
+    if (!(rec= page_rec_get_next_const(rec)) || page_rec_is_supremum(rec))
+      return DB_CORRUPTION;
+    /* The first node pointer on the leftmost page of a level is
+    smaller than any key; it cannot bound a range. */
+    if (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG)
+      continue;
+    if (n_recs <= max_bounds || (i * max_bounds) % n_recs < max_bounds)
+      bounds.push_back(row_count_copy_bound(rec, index, heap));
+  }
+  return DB_SUCCESS;
+}
+
+/** Split the clustered index into key ranges at the node pointers of the
+highest level that has enough of them: the root page, or the pages right
+below it.
+@param index       clustered index
+@param max_ranges  maximum number of ranges
+@param bounds      ascending range bounds
+@param heap        memory heap for the bounds
+@param mtr         mini-transaction
+@return error code */
+static dberr_t row_count_split(dict_index_t *index, ulint max_ranges,
+                               std::vector<const dtuple_t*> &bounds,
+                               mem_heap_t *heap, mtr_t *mtr)
+{
+  dberr_t err;
+  const buf_block_t *root= btr_root_block_get(index, RW_S_LATCH, mtr, &err);
+  if (!root)
+    return err;
+
+  const page_t *page= root->page.frame;
+  if (page_is_leaf(page))
+    return DB_SUCCESS;
+
+  const ulint n_children= page_get_n_recs(page);
+  if (n_children >= max_ranges || btr_page_get_level(page) == 1)
+    return row_count_page_bounds(root, index, max_ranges - 1, bounds, heap);
+
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs_init(offsets_);
+  mem_heap_t *offsets_heap= nullptr;
+  const ulint per_child= (max_ranges + n_children - 1) / n_children;
+  const rec_t *rec= page_get_infimum_rec(page);
+
+  for (ulint i= 0; i < n_children && err == DB_SUCCESS; i++)
+  {
+    if (!(rec= page_rec_get_next_const(rec)) || page_rec_is_supremum(rec))
+    {
+      err= DB_CORRUPTION;
+      break;
+    }
+    const rec_offs *offsets= rec_get_offsets(rec, index, offsets_, 0,
+                                             ULINT_UNDEFINED, &offsets_heap);
+    const auto savepoint= mtr->get_savepoint();
+    if (const buf_block_t *child=
+        btr_block_get(*index, btr_node_ptr_get_child_page_no(rec, offsets),
+                      RW_S_LATCH, mtr, &err))
+      err= row_count_page_bounds(child, index, per_child, bounds, heap);
+    mtr->rollback_to_savepoint(savepoint);
+  }
+
+  if (offsets_heap)
+    mem_heap_free(offsets_heap);
+  return err;
+}
+
+/** Count the visible records of one key range.
+@param ctx        scan state
+@param low        smallest key of the range, or nullptr
+@param high       key after the range, or nullptr
+@param heap       memory heap for record offsets
+@param vers_heap  memory heap for old record versions
+@param n_rows     number of records counted
+@return error code */
+static dberr_t row_count_range(row_count_ctx *ctx, const dtuple_t *low,
+                               const dtuple_t *high, mem_heap_t **heap,
+                               mem_heap_t *vers_heap, ulint *n_rows)
+{
+  dict_index_t *const index= ctx->index;
+  const bool comp= index->table->not_redundant();
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs_init(offsets_);
+
+  btr_pcur_t pcur;
+  pcur.btr_cur.page_cur.index= index;
+  /* The tasks share the transaction, so it is not passed to the
+  mini-transaction, which would update its statistics. */
+  mtr_t mtr{nullptr};
+  mtr.start();
+
+  dberr_t err= low
+    ? btr_pcur_open(low, PAGE_CUR_GE, BTR_SEARCH_LEAF, &pcur, &mtr)
+    : pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+
+  while (err == DB_SUCCESS)
+  {
+    const rec_t *rec= btr_pcur_get_rec(&pcur);
+
+    if (page_rec_is_supremum(rec))
+    {
+      if (btr_pcur_is_after_last_in_tree(&pcur))
+        break;
+      err= btr_pcur_move_to_next_page(&pcur, &mtr);
+      if (err == DB_SUCCESS &&
+          (ctx->err != DB_SUCCESS || trx_is_interrupted(ctx->trx)))
+        err= DB_INTERRUPTED;
+      continue;
+    }
+
+    if (!page_rec_is_infimum(rec))
+    {
+      rec_offs *offsets= rec_get_offsets(rec, index, offsets_,
+                                         index->n_core_fields,
+                                         ULINT_UNDEFINED, heap);
+      if (high && cmp_dtuple_rec(high, rec, index, offsets) <= 0)
+        break;
+
+      if (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG);
+      else if (!ctx->view ||
+               ctx->view->changes_visible(row_get_rec_trx_id(rec, index,
+                                                             offsets)))
+        *n_rows+= !rec_get_deleted_flag(rec, comp);
+      else
+      {
+        rec_t *old_vers;
+        mem_heap_empty(vers_heap);
+        err= row_vers_build_for_consistent_read(rec, &mtr, index, &offsets,
+                                                ctx->view, heap, vers_heap,
+                                                &old_vers, nullptr);
+        if (err != DB_SUCCESS)
+          break;
+        *n_rows+= old_vers && !rec_get_deleted_flag(old_vers, comp);
+      }
+      mem_heap_empty(*heap);
+    }
+
+    if (!btr_pcur_move_to_next_on_page(&pcur))
+      err= DB_CORRUPTION;
+  }
+
+  mtr.commit();
+  ut_free(pcur.old_rec_buf);
+  return err;
+}
+
+/** Scan key ranges of row_count_parallel() until none are left.
+@param arg  row_count_ctx */
+static void row_count_task(void *arg)
+{
+  row_count_ctx *ctx= static_cast<row_count_ctx*>(arg);
+  mem_heap_t *heap= mem_heap_create(256);
+  mem_heap_t *vers_heap= mem_heap_create(srv_page_size);
+  ulint n_rows= 0;
+
+  while (ctx->err == DB_SUCCESS)
+  {
+    const ulint i= ctx->next_range++;
+    if (i >= ctx->n_ranges)
+      break;
+    if (dberr_t err= row_count_range(ctx, i ? ctx->bounds[i - 1] : nullptr,
+                                     i + 1 < ctx->n_ranges
+                                     ? ctx->bounds[i] : nullptr,
+                                     &heap, vers_heap, &n_rows))
+      ctx->set_error(err);
+  }
+
+  ctx->n_rows+= n_rows;
+  mem_heap_free(vers_heap);
+  mem_heap_free(heap);
+}
+
+dberr_t row_count_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                           ulint *n_rows, ulint *n_ranges)
+{
+  dict_index_t *const index= dict_table_get_first_index(prebuilt->table);
+  trx_t *const trx= prebuilt->trx;
+  ut_ad(index->is_primary());
+  ut_ad(n_threads >= 1);
+
+  *n_rows= 0;
+  *n_ranges= 0;
+
+  ReadView *view= prebuilt->table->is_temporary() ||
+    trx->isolation_level == TRX_ISO_READ_UNCOMMITTED
+    ? nullptr : &trx->read_view;
+  ut_ad(!view || view->is_open());
+
+  if (const trx_id_t bulk_trx_id= index->table->bulk_trx_id)
+    if (view && !view->changes_visible(bulk_trx_id))
+      return DB_SUCCESS;
+
+  mem_heap_t *heap= mem_heap_create(1024);
+  std::vector<const dtuple_t*> bounds;
+  mtr_t mtr{trx};
+  mtr.start();
+  dberr_t err= row_count_split(index, n_threads * ROW_COUNT_RANGES_PER_THREAD,
+                               bounds, heap, &mtr);
+  mtr.commit();
+
+  if (err == DB_SUCCESS)
+  {
+    row_count_ctx ctx;
+    ctx.index= index;
+    ctx.trx= trx;
+    ctx.view= view;
+    ctx.bounds= bounds.data();
+    ctx.n_ranges= bounds.size() + 1;
+    ctx.next_range= 0;
+    ctx.n_rows= 0;
+    ctx.err= DB_SUCCESS;
+
+    std::vector<tpool::waitable_task*> tasks;
+    for (ulint i= 1; i < std::min(n_threads, ctx.n_ranges); i++)
+    {
+      tasks.push_back(new tpool::waitable_task(row_count_task, &ctx));
+      srv_thread_pool->submit_task(tasks.back());
+    }
+
+    row_count_task(&ctx);
+
+    for (tpool::waitable_task *task : tasks)
+    {
+      task->wait();
+      delete task;
+    }
+
+    err= ctx.err;
+    *n_rows= ctx.n_rows;
+    *n_ranges= ctx.n_ranges;
+  }
+
+  mem_heap_free(heap);
+  return err;
+}
@@ -128,6 +128,9 @@ bool high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** Maximum number of secondary indexes that are sorted and loaded
+concurrently in index creation */
+uint	srv_ddl_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -141,8 +144,11 @@ my_bool	srv_use_native_aio;
 ulong	srv_linux_aio_method;
 #endif
 my_bool	srv_numa_interleave;
+my_bool	srv_numa_node_local;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
+/** innodb_doublewrite_pipeline */
+my_bool	srv_doublewrite_pipeline;
 /** innodb_compression_algorithm; used with page compression */
 ulong	innodb_compression_algorithm;
 
@@ -197,6 +203,8 @@ ulong	srv_checksum_algorithm;
 uint	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 uint	srv_n_write_io_threads;
+/** innodb_log_recovery_threads */
+uint	srv_log_recovery_threads;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
@@ -204,6 +212,8 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_scan_depth */
+uint	srv_read_ahead_scan_depth;
 
 /** copy of innodb_open_files; @see innodb_init_params() */
 ulint	srv_max_n_open_files;
@@ -45,6 +45,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "data0type.h"
 #include "dict0dict.h"
 #include "buf0buf.h"
+#include "buf0ccache.h"
 #include "buf0dblwr.h"
 #include "buf0dump.h"
 #include "os0file.h"
@@ -1430,6 +1431,8 @@ dberr_t srv_start(bool create_new_db)
 		return(srv_init_abort(DB_ERROR));
 	}
 
+	buf_ccache.create();
+
 	log_sys.create();
 	recv_sys.create();
 	lock_sys.create(srv_lock_table_size = 5 * buf_pool.curr_size());
@@ -1651,10 +1654,12 @@ dberr_t srv_start(bool create_new_db)
 			respective file pages, for the last batch of
 			recv_group_scan_log_recs().
 			Since it may generate huge batch of threadpool tasks,
-			for read io task group, scale down thread creation rate
-			by temporarily restricting tpool concurrency.
+			for read io task group, limit thread creation rate
+			by temporarily restricting tpool concurrency to the
+			number of tasks that may apply the log.
 			*/
-			srv_thread_pool->set_concurrency(srv_n_read_io_threads);
+			srv_thread_pool->set_concurrency(
+				recv_sys_t::apply_threads());
 
 			mysql_mutex_lock(&recv_sys.mutex);
 			recv_sys.apply(true);
@@ -2110,6 +2115,7 @@ void innodb_shutdown()
 
         innodb_binlog_close(true);
 	os_aio_free();
+	buf_ccache.close();
 	fil_space_t::close_all();
 	/* Exit any remaining threads. */
 	ut_ad(!buf_page_cleaner_is_active);
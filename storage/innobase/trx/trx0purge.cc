@@ -1204,8 +1204,36 @@ dict_table_t *purge_sys_t::close_and_reopen(table_id_t id, THD *thd,
   return table;
 }
 
+/** The undo log records of one table in a purge batch */
+struct trx_purge_table_work
+{
+  /** the table and its meta-data lock; table==nullptr if it was dropped */
+  std::pair<dict_table_t*,MDL_ticket*> p;
+  /** undo log records of the table, in history order */
+  std::vector<trx_purge_rec_t> recs;
+
+  /** @return the estimated amount of work: every undo log record may
+  require an operation in each index of the table, and purging the
+  secondary indexes is what keeps them from bloating */
+  size_t weight() const
+  {
+    return p.first ? recs.size() * UT_LIST_GET_LEN(p.first->indexes) : 0;
+  }
+};
+
 /** Run a purge batch.
-@param n_work_items     number of work items (currently tables) to process
+
+The undo log records are collected per table. The tables are then
+distributed over the purge nodes, largest first, each one to the node that
+has the least work so far. The work of a table is never split between
+nodes, so that its records are purged in history order. Because the
+nodes are queued in the order of their first table, the largest tables
+are picked up by the purge tasks first, and a burst of updates in one
+table does not hold up the completion of the batch more than necessary.
+The backlog is not reported per table; only its total is visible as
+Innodb_history_list_length.
+
+@param n_work_items     number of work items (purge nodes) to process
 @return new purge_sys.head */
 static purge_sys_t::iterator
 trx_purge_attach_undo_recs(trx_t *trx, ulint *n_work_items) noexcept
@@ -1214,9 +1242,9 @@ trx_purge_attach_undo_recs(trx_t *trx, ulint *n_work_items) noexcept
   purge_sys_t::iterator head= purge_sys.tail;
 
   /* Fetch and parse the UNDO records. The UNDO records are added
-  to a per purge node vector. */
+  to a per table vector. */
 
-  std::unordered_map<table_id_t, purge_node_t *>
+  std::unordered_map<table_id_t, trx_purge_table_work>
     table_id_map(TRX_PURGE_TABLE_BUCKETS);
   purge_sys.m_active= true;
 
@@ -1242,40 +1270,67 @@ trx_purge_attach_undo_recs(trx_t *trx, ulint *n_work_items) noexcept
 
     table_id_t table_id= trx_undo_rec_get_table_id(purge_rec.undo_rec);
 
-    purge_node_t *&table_node= table_id_map[table_id];
-    if (table_node)
-      ut_ad(!table_node->in_progress);
-    if (!table_node)
+    auto found= table_id_map.emplace(table_id, trx_purge_table_work{});
+    trx_purge_table_work &work= found.first->second;
+    if (found.second)
     {
-      std::pair<dict_table_t *, MDL_ticket *> p;
+      std::pair<dict_table_t *, MDL_ticket *> &p= work.p;
       p.first= trx_purge_table_open(table_id, &thd->mdl_context, &p.second);
       if (p.first == reinterpret_cast<dict_table_t *>(-1))
         p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
-
-      if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
-        thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
-      ++*n_work_items;
-      table_node= static_cast<purge_node_t *>(thr->child);
-
-      ut_a(que_node_get_type(table_node) == QUE_NODE_PURGE);
-      ut_d(auto pair=) table_node->tables.emplace(table_id, p);
-      ut_ad(pair.second);
-      if (p.first)
-        goto enqueue;
-    }
-    else if (table_node->tables[table_id].first)
-    {
-    enqueue:
-      table_node->undo_recs.push(purge_rec);
-      ut_ad(!table_node->in_progress);
     }
 
+    if (work.p.first)
+      work.recs.push_back(purge_rec);
+
     const size_t size{purge_sys.n_pages_handled()};
     if (size >= size_t{srv_purge_batch_size} ||
         size >= buf_pool.usable_size() * 3 / 4)
       break;
   }
 
+  typedef std::pair<const table_id_t, trx_purge_table_work> table_work;
+  std::vector<std::pair<size_t, table_work*>> order;
+  order.reserve(table_id_map.size());
+  for (table_work &t : table_id_map)
+    order.emplace_back(t.second.weight(), &t);
+  std::stable_sort(order.begin(), order.end(),
+                   [](const std::pair<size_t, table_work*> &a,
+                      const std::pair<size_t, table_work*> &b)
+                   { return a.first > b.first; });
+
+  const ulint n_nodes{std::min<ulint>(order.size(), innodb_purge_threads_MAX)};
+  size_t load[innodb_purge_threads_MAX];
+  purge_node_t *nodes[innodb_purge_threads_MAX];
+
+  for (ulint i= 0; i < n_nodes; i++)
+  {
+    thr= thr ? UT_LIST_GET_NEXT(thrs, thr)
+      : UT_LIST_GET_FIRST(purge_sys.query->thrs);
+    nodes[i]= static_cast<purge_node_t *>(thr->child);
+    ut_a(que_node_get_type(nodes[i]) == QUE_NODE_PURGE);
+    ut_ad(!nodes[i]->in_progress);
+    load[i]= 0;
+  }
+
+  for (const auto &o : order)
+  {
+    ulint n= 0;
+    for (ulint i= 1; i < n_nodes; i++)
+      if (load[i] < load[n])
+        n= i;
+    load[n]+= o.first;
+
+    purge_node_t *node= nodes[n];
+    const trx_purge_table_work &work= o.second->second;
+    ut_d(auto pair=) node->tables.emplace(o.second->first, work.p);
+    ut_ad(pair.second);
+    for (const trx_purge_rec_t &rec : work.recs)
+      node->undo_recs.push(rec);
+  }
+
+  *n_work_items= n_nodes;
+
 #ifdef UNIV_DEBUG
   thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
   for (ulint i= 0; thr && i < *n_work_items;
@@ -159,6 +159,8 @@ trx_init(
 
 	trx->lock.rec_cached = 0;
 
+	trx->lock.last_rec_lock = nullptr;
+
 	trx->lock.table_cached = 0;
 #ifdef WITH_WSREP
 	ut_ad(!trx->wsrep);
@@ -35,6 +35,9 @@
 #ifdef FIONREAD_IN_SYS_FILIO
 # include <sys/filio.h>
 #endif
+#ifdef HAVE_SENDFILE
+# include <sys/sendfile.h>
+#endif
 
 /* Network io wait callbacks  for threadpool */
 static void (*before_io_wait)(void)= 0;
@@ -286,6 +289,78 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+
+/**
+  Send size bytes of the file fd, starting at offset, with sendfile(), so
+  that the data is not copied through user space. Only plain sockets are
+  supported; the write timeout of the vio is respected.
+
+  @return size on success, -1 on failure (errno is ENOSYS if sendfile() is
+          not available or not usable for this vio)
+*/
+
+size_t vio_sendfile(Vio *vio, File fd, my_off_t offset, size_t size)
+{
+#ifdef HAVE_SENDFILE
+  my_bool old_mode= FALSE;
+  size_t sent= 0;
+  int ret= 0;
+  DBUG_ENTER("vio_sendfile");
+  DBUG_PRINT("enter", ("sd: %d  fd: %d  offset: %llu  size: %zu",
+                       (int)mysql_socket_getfd(vio->mysql_socket), fd,
+                       (ulonglong) offset, size));
+
+  if (vio->type != VIO_TYPE_TCPIP && vio->type != VIO_TYPE_SOCKET)
+  {
+    errno= ENOSYS;
+    DBUG_RETURN((size_t) -1);
+  }
+  /*
+    There is no MSG_DONTWAIT for sendfile(), so make the socket non-blocking
+    for the duration of the call if a write timeout is to be respected.
+  */
+  if (vio->write_timeout >= 0 && vio_blocking(vio, FALSE, &old_mode))
+    DBUG_RETURN((size_t) -1);
+
+  while (sent < size)
+  {
+    off_t pos= (off_t) (offset + sent);
+    ssize_t len= sendfile(mysql_socket_getfd(vio->mysql_socket), fd, &pos,
+                          MY_MIN(size - sent, (size_t) 0x7ffff000));
+    if (len > 0)
+      sent+= (size_t) len;
+    else if (len == 0)
+    {
+      /* The file is shorter than expected. */
+      ret= -1;
+      break;
+    }
+    else if (errno == EINTR)
+      continue;
+    else if (errno != SOCKET_EAGAIN && errno != SOCKET_EWOULDBLOCK)
+    {
+      ret= -1;
+      break;
+    }
+    else if ((ret= vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE)))
+      break;
+  }
+
+  if (vio->write_timeout >= 0 && old_mode)
+  {
+    my_bool not_used;
+    int save_errno= errno;
+    vio_blocking(vio, TRUE, &not_used);
+    errno= save_errno;
+  }
+  DBUG_PRINT("exit", ("%d", ret));
+  DBUG_RETURN(ret ? (size_t) -1 : size);
+#else
+  errno= ENOSYS;
+  return (size_t) -1;
+#endif
+}
+
 int vio_socket_shutdown(Vio *vio, int how)
 {
   int ret;